@@ -0,0 +1,434 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ActorActions/ActorLabelIndex.h"
+#include "Editor.h"
+#include "EngineUtils.h"
+#include "Engine/Level.h"
+#include "Internationalization/Regex.h"
+#include "Misc/CoreDelegates.h"
+#include "Algo/BinarySearch.h"
+
+void FActorLabelIndex::Initialize()
+{
+	LevelActorAddedHandle = GEngine->OnLevelActorAdded().AddRaw(this,&FActorLabelIndex::OnLevelActorAdded);
+	LevelActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this,&FActorLabelIndex::OnLevelActorDeleted);
+	ActorLabelChangedHandle = FCoreDelegates::OnActorLabelChanged.AddRaw(this,&FActorLabelIndex::OnActorLabelChanged);
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddRaw(this,&FActorLabelIndex::OnLevelChanged);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this,&FActorLabelIndex::OnLevelChanged);
+	WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddRaw(this,&FActorLabelIndex::OnWorldCleanup);
+	PostUndoRedoHandle = FEditorDelegates::PostUndoRedo.AddRaw(this,&FActorLabelIndex::OnPostUndoRedo);
+}
+
+void FActorLabelIndex::Shutdown()
+{
+	if(GEngine)
+	{
+		GEngine->OnLevelActorAdded().Remove(LevelActorAddedHandle);
+		GEngine->OnLevelActorDeleted().Remove(LevelActorDeletedHandle);
+	}
+
+	FCoreDelegates::OnActorLabelChanged.Remove(ActorLabelChangedHandle);
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+	FEditorDelegates::PostUndoRedo.Remove(PostUndoRedoHandle);
+
+	IndicesByWorld.Empty();
+}
+
+void FActorLabelIndex::FindActors(UWorld* World, const FString& Pattern, EActorLabelMatchMode MatchMode, 
+ESearchCase::Type SearchCase, TArray<AActor*>& OutActors)
+{
+	OutActors.Empty();
+
+	if(!World || Pattern.IsEmpty()) return;
+
+	FWorldLabelIndex& WorldIndex = GetIndexForWorld(World);
+
+	TArray<int32> CandidateEntryIndices;
+
+	if(MatchMode == EActorLabelMatchMode::EALMM_Regex)
+	{
+		//Regex is matched on the real label, case handled by the pattern flag
+		const FRegexPattern RegexPattern(SearchCase == ESearchCase::IgnoreCase ? TEXT("(?i)") + Pattern : Pattern);
+
+		for(int32 EntryIndex = 0; EntryIndex<WorldIndex.Entries.Num(); EntryIndex++)
+		{
+			if(!WorldIndex.Entries[EntryIndex].Actor.IsValid()) continue;
+
+			FRegexMatcher RegexMatcher(RegexPattern,WorldIndex.Entries[EntryIndex].Label);
+
+			if(RegexMatcher.FindNext())
+			{
+				CandidateEntryIndices.Add(EntryIndex);
+			}
+		}
+	}
+	else
+	{
+		FindCandidates(WorldIndex,Pattern.ToLower(),MatchMode,CandidateEntryIndices);
+	}
+
+	OutActors.Reserve(CandidateEntryIndices.Num());
+
+	for(const int32 EntryIndex:CandidateEntryIndices)
+	{
+		const FLabelEntry& Entry = WorldIndex.Entries[EntryIndex];
+		AActor* Actor = Entry.Actor.Get();
+
+		if(!Actor) continue;
+
+		//Index is lowercase, case sensitive queries check the candidates against the real label
+		if(SearchCase == ESearchCase::CaseSensitive)
+		{
+			bool bMatches = true;
+
+			switch(MatchMode)
+			{
+			case EActorLabelMatchMode::EALMM_Prefix:
+				bMatches = Entry.Label.StartsWith(Pattern,ESearchCase::CaseSensitive);
+				break;
+
+			case EActorLabelMatchMode::EALMM_Token:
+			case EActorLabelMatchMode::EALMM_Contains:
+				bMatches = Entry.Label.Contains(Pattern,ESearchCase::CaseSensitive);
+				break;
+
+			case EActorLabelMatchMode::EALMM_Glob:
+				bMatches = Entry.Label.MatchesWildcard(Pattern,ESearchCase::CaseSensitive);
+				break;
+
+			default:
+				break;
+			}
+
+			if(!bMatches) continue;
+		}
+
+		OutActors.Add(Actor);
+	}
+}
+
+FString FActorLabelIndex::StripNumericSuffix(const FString& ActorLabel)
+{
+	int32 NewLength = ActorLabel.Len();
+
+	while(NewLength>0 && FChar::IsDigit(ActorLabel[NewLength-1])) --NewLength;
+	while(NewLength>0 && (ActorLabel[NewLength-1]==TEXT('_') || ActorLabel[NewLength-1]==TEXT(' '))) --NewLength;
+
+	//A label that is only a number is kept as it is
+	return NewLength>0 ? ActorLabel.Left(NewLength) : ActorLabel;
+}
+
+#pragma region WorldLabelIndex
+
+FActorLabelIndex::FWorldLabelIndex::~FWorldLabelIndex()
+{
+	for(const TPair<TWeakObjectPtr<ULevel>,FDelegateHandle>& LevelHandle:LoadedActorAddedHandles)
+	{
+		if(ULevel* Level = LevelHandle.Key.Get())
+		{
+			Level->OnLoadedActorAddedToLevelEvent.Remove(LevelHandle.Value);
+		}
+	}
+
+	for(const TPair<TWeakObjectPtr<ULevel>,FDelegateHandle>& LevelHandle:LoadedActorRemovedHandles)
+	{
+		if(ULevel* Level = LevelHandle.Key.Get())
+		{
+			Level->OnLoadedActorRemovedFromLevelEvent.Remove(LevelHandle.Value);
+		}
+	}
+}
+
+void FActorLabelIndex::FWorldLabelIndex::AddActor(AActor* Actor)
+{
+	if(EntryIndexByActor.Contains(Actor)) return;
+
+	const int32 EntryIndex = FreeEntryIndices.Num()>0 ? FreeEntryIndices.Pop(false) : Entries.AddDefaulted();
+
+	FLabelEntry& Entry = Entries[EntryIndex];
+	Entry.Actor = Actor;
+	Entry.Label = Actor->GetActorLabel();
+	Entry.LowerLabel = Entry.Label.ToLower();
+
+	EntryIndexByActor.Add(Actor,EntryIndex);
+
+	TArray<FString> Tokens;
+	Tokenize(Entry.LowerLabel,Tokens);
+
+	for(FString& Token:Tokens)
+	{
+		EntryIndicesByToken.FindOrAdd(MoveTemp(Token)).Add(EntryIndex);
+	}
+
+	bSortedEntriesDirty = true;
+}
+
+void FActorLabelIndex::FWorldLabelIndex::RemoveActor(AActor* Actor)
+{
+	int32 EntryIndex = INDEX_NONE;
+
+	if(!EntryIndexByActor.RemoveAndCopyValue(Actor,EntryIndex)) return;
+
+	FLabelEntry& Entry = Entries[EntryIndex];
+
+	TArray<FString> Tokens;
+	Tokenize(Entry.LowerLabel,Tokens);
+
+	for(const FString& Token:Tokens)
+	{
+		if(TArray<int32>* TokenEntryIndices = EntryIndicesByToken.Find(Token))
+		{
+			TokenEntryIndices->RemoveSingleSwap(EntryIndex,false);
+
+			if(TokenEntryIndices->Num()==0)
+			{
+				EntryIndicesByToken.Remove(Token);
+			}
+		}
+	}
+
+	Entry = FLabelEntry();
+	FreeEntryIndices.Add(EntryIndex);
+
+	bSortedEntriesDirty = true;
+}
+
+void FActorLabelIndex::FWorldLabelIndex::SortEntries()
+{
+	SortedEntryIndices.Reset(Entries.Num());
+
+	for(int32 EntryIndex = 0; EntryIndex<Entries.Num(); EntryIndex++)
+	{
+		if(Entries[EntryIndex].Actor.IsValid())
+		{
+			SortedEntryIndices.Add(EntryIndex);
+		}
+	}
+
+	SortedEntryIndices.Sort([this](int32 A, int32 B)
+	{
+		return Entries[A].LowerLabel.Compare(Entries[B].LowerLabel,ESearchCase::CaseSensitive) < 0;
+	});
+
+	bSortedEntriesDirty = false;
+}
+
+#pragma endregion
+
+FActorLabelIndex::FWorldLabelIndex& FActorLabelIndex::GetIndexForWorld(UWorld* World)
+{
+	if(TUniquePtr<FWorldLabelIndex>* ExistingIndex = IndicesByWorld.Find(World))
+	{
+		return **ExistingIndex;
+	}
+
+	TUniquePtr<FWorldLabelIndex>& WorldIndex = IndicesByWorld.Add(World,MakeUnique<FWorldLabelIndex>());
+
+	for(ULevel* Level:World->GetLevels())
+	{
+		if(!Level) continue;
+
+		WorldIndex->LoadedActorAddedHandles.Emplace(Level,
+		Level->OnLoadedActorAddedToLevelEvent.AddRaw(this,&FActorLabelIndex::OnLoadedActorAdded));
+
+		WorldIndex->LoadedActorRemovedHandles.Emplace(Level,
+		Level->OnLoadedActorRemovedFromLevelEvent.AddRaw(this,&FActorLabelIndex::OnLoadedActorRemoved));
+	}
+
+	for(TActorIterator<AActor> ActorIt(World); ActorIt; ++ActorIt)
+	{
+		if(ShouldIndexActor(*ActorIt))
+		{
+			WorldIndex->AddActor(*ActorIt);
+		}
+	}
+
+	return *WorldIndex;
+}
+
+void FActorLabelIndex::FindCandidates(FWorldLabelIndex& WorldIndex, const FString& LowerPattern, 
+EActorLabelMatchMode MatchMode, TArray<int32>& OutEntryIndices) const
+{
+	switch(MatchMode)
+	{
+	case EActorLabelMatchMode::EALMM_Prefix:
+
+		FindByPrefix(WorldIndex,LowerPattern,OutEntryIndices);
+		break;
+
+	case EActorLabelMatchMode::EALMM_Token:
+
+		if(const TArray<int32>* TokenEntryIndices = WorldIndex.EntryIndicesByToken.Find(LowerPattern))
+		{
+			OutEntryIndices = *TokenEntryIndices;
+		}
+		break;
+
+	case EActorLabelMatchMode::EALMM_Contains:
+
+		for(int32 EntryIndex = 0; EntryIndex<WorldIndex.Entries.Num(); EntryIndex++)
+		{
+			const FLabelEntry& Entry = WorldIndex.Entries[EntryIndex];
+
+			if(Entry.Actor.IsValid() && Entry.LowerLabel.Contains(LowerPattern,ESearchCase::CaseSensitive))
+			{
+				OutEntryIndices.Add(EntryIndex);
+			}
+		}
+		break;
+
+	case EActorLabelMatchMode::EALMM_Glob:
+	{
+		//Text before the first wildcard narrows the glob down to a prefix range
+		int32 FirstWildcardIndex = INDEX_NONE;
+
+		for(int32 CharIndex = 0; CharIndex<LowerPattern.Len(); CharIndex++)
+		{
+			if(LowerPattern[CharIndex]==TEXT('*') || LowerPattern[CharIndex]==TEXT('?'))
+			{
+				FirstWildcardIndex = CharIndex;
+				break;
+			}
+		}
+
+		TArray<int32> PrefixEntryIndices;
+		FindByPrefix(WorldIndex,FirstWildcardIndex==INDEX_NONE ? LowerPattern : LowerPattern.Left(FirstWildcardIndex),PrefixEntryIndices);
+
+		for(const int32 EntryIndex:PrefixEntryIndices)
+		{
+			if(WorldIndex.Entries[EntryIndex].LowerLabel.MatchesWildcard(LowerPattern,ESearchCase::CaseSensitive))
+			{
+				OutEntryIndices.Add(EntryIndex);
+			}
+		}
+		break;
+	}
+
+	default:
+		break;
+	}
+}
+
+void FActorLabelIndex::FindByPrefix(FWorldLabelIndex& WorldIndex, const FString& LowerPrefix, 
+TArray<int32>& OutEntryIndices) const
+{
+	if(WorldIndex.bSortedEntriesDirty)
+	{
+		WorldIndex.SortEntries();
+	}
+
+	const TArray<FLabelEntry>& Entries = WorldIndex.Entries;
+
+	//First label not less than the prefix, every label starting with it follows
+	int32 RangeStart = Algo::LowerBound(WorldIndex.SortedEntryIndices,LowerPrefix,[&Entries](int32 EntryIndex, const FString& Value)
+	{
+		return Entries[EntryIndex].LowerLabel.Compare(Value,ESearchCase::CaseSensitive) < 0;
+	});
+
+	for(; RangeStart<WorldIndex.SortedEntryIndices.Num(); RangeStart++)
+	{
+		const int32 EntryIndex = WorldIndex.SortedEntryIndices[RangeStart];
+
+		if(!Entries[EntryIndex].LowerLabel.StartsWith(LowerPrefix,ESearchCase::CaseSensitive)) break;
+
+		OutEntryIndices.Add(EntryIndex);
+	}
+}
+
+void FActorLabelIndex::Tokenize(const FString& LowerLabel, TArray<FString>& OutTokens)
+{
+	//Split on separators and between letters and digits
+	FString CurrentToken;
+
+	for(int32 CharIndex = 0; CharIndex<=LowerLabel.Len(); CharIndex++)
+	{
+		const TCHAR Char = CharIndex<LowerLabel.Len() ? LowerLabel[CharIndex] : TEXT('\0');
+		const bool bSeparator = Char==TEXT('\0') || Char==TEXT('_') || Char==TEXT(' ') || Char==TEXT('-') || Char==TEXT('.');
+
+		const bool bDigitBoundary = !bSeparator && !CurrentToken.IsEmpty() && 
+		FChar::IsDigit(Char) != FChar::IsDigit(CurrentToken[CurrentToken.Len()-1]);
+
+		if((bSeparator || bDigitBoundary) && !CurrentToken.IsEmpty())
+		{
+			OutTokens.AddUnique(MoveTemp(CurrentToken));
+			CurrentToken.Reset();
+		}
+
+		if(!bSeparator)
+		{
+			CurrentToken.AppendChar(Char);
+		}
+	}
+}
+
+bool FActorLabelIndex::ShouldIndexActor(const AActor* Actor)
+{
+	return IsValid(Actor) && !Actor->IsTemplate() && !Actor->HasAnyFlags(RF_Transient);
+}
+
+#pragma region IndexUpdates
+
+void FActorLabelIndex::OnLevelActorAdded(AActor* AddedActor)
+{
+	if(!ShouldIndexActor(AddedActor)) return;
+
+	//Worlds not queried yet are indexed on their first query
+	if(TUniquePtr<FWorldLabelIndex>* WorldIndex = IndicesByWorld.Find(AddedActor->GetWorld()))
+	{
+		(*WorldIndex)->AddActor(AddedActor);
+	}
+}
+
+void FActorLabelIndex::OnLevelActorDeleted(AActor* DeletedActor)
+{
+	if(!DeletedActor) return;
+
+	if(TUniquePtr<FWorldLabelIndex>* WorldIndex = IndicesByWorld.Find(DeletedActor->GetWorld()))
+	{
+		(*WorldIndex)->RemoveActor(DeletedActor);
+	}
+}
+
+void FActorLabelIndex::OnActorLabelChanged(AActor* RenamedActor)
+{
+	if(!ShouldIndexActor(RenamedActor)) return;
+
+	if(TUniquePtr<FWorldLabelIndex>* WorldIndex = IndicesByWorld.Find(RenamedActor->GetWorld()))
+	{
+		(*WorldIndex)->RemoveActor(RenamedActor);
+		(*WorldIndex)->AddActor(RenamedActor);
+	}
+}
+
+//World Partition loads actors into the persistent level without the level actor added and deleted events
+void FActorLabelIndex::OnLoadedActorAdded(AActor& LoadedActor)
+{
+	OnLevelActorAdded(&LoadedActor);
+}
+
+void FActorLabelIndex::OnLoadedActorRemoved(AActor& UnloadedActor)
+{
+	OnLevelActorDeleted(&UnloadedActor);
+}
+
+//Streaming levels bring in or take out many actors at once, the world is indexed again on its next query
+void FActorLabelIndex::OnLevelChanged(ULevel* Level, UWorld* World)
+{
+	IndicesByWorld.Remove(World);
+}
+
+void FActorLabelIndex::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	IndicesByWorld.Remove(World);
+}
+
+//Undo and redo restore deleted actors and old labels without the added and label changed events,
+//every world is indexed again on its next query
+void FActorLabelIndex::OnPostUndoRedo()
+{
+	IndicesByWorld.Empty();
+}
+
+#pragma endregion
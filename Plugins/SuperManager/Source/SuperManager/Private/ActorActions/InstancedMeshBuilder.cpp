@@ -0,0 +1,183 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ActorActions/InstancedMeshBuilder.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "InstancedFoliageActor.h"
+#include "FoliageInstancedStaticMeshComponent.h"
+
+bool FInstancedMeshBuilder::MakeKey(const AStaticMeshActor* StaticMeshActor, FInstancedMeshKey& OutKey)
+{
+	if(!StaticMeshActor) return false;
+
+	const UStaticMeshComponent* StaticMeshComponent = StaticMeshActor->GetStaticMeshComponent();
+
+	if(!StaticMeshComponent || !StaticMeshComponent->GetStaticMesh()) return false;
+
+	OutKey.Level = StaticMeshActor->GetLevel();
+	OutKey.StaticMesh = StaticMeshComponent->GetStaticMesh();
+	OutKey.Materials.Reset();
+
+	//Includes the material overrides of the component
+	for(int32 MaterialIndex = 0; MaterialIndex<StaticMeshComponent->GetNumMaterials(); MaterialIndex++)
+	{
+		OutKey.Materials.Add(StaticMeshComponent->GetMaterial(MaterialIndex));
+	}
+
+	OutKey.CollisionProfileName = StaticMeshComponent->GetCollisionProfileName();
+	OutKey.CollisionEnabled = StaticMeshComponent->GetCollisionEnabled();
+
+	OutKey.Mobility = StaticMeshComponent->Mobility;
+	OutKey.bCastShadow = StaticMeshComponent->CastShadow;
+
+	OutKey.Tags = StaticMeshActor->Tags;
+	OutKey.Tags.Sort(FNameLexicalLess());
+
+	return true;
+}
+
+AActor* FInstancedMeshBuilder::SpawnInstancedMeshActor(UWorld* World, const FInstancedMeshKey& Key, 
+const TArray<FTransform>& InstanceWorldTransforms, const FString& ActorLabel)
+{
+	if(!World || !Key.StaticMesh || InstanceWorldTransforms.Num()==0) return nullptr;
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.ObjectFlags = RF_Transactional;
+	SpawnParameters.OverrideLevel = Key.Level;
+
+	//Actor sits at the first instance so the instances keep small local offsets
+	const FTransform ActorTransform(InstanceWorldTransforms[0].GetLocation());
+
+	AActor* InstancedMeshActor = World->SpawnActor<AActor>(AActor::StaticClass(),ActorTransform,SpawnParameters);
+
+	if(!InstancedMeshActor) return nullptr;
+
+	UHierarchicalInstancedStaticMeshComponent* InstancedMeshComponent =
+	NewObject<UHierarchicalInstancedStaticMeshComponent>(InstancedMeshActor,TEXT("InstancedStaticMesh"),RF_Transactional);
+
+	InstancedMeshComponent->SetMobility(Key.Mobility);
+	InstancedMeshComponent->SetCastShadow(Key.bCastShadow);
+	InstancedMeshComponent->SetStaticMesh(Key.StaticMesh);
+	InstancedMeshComponent->SetCollisionProfileName(Key.CollisionProfileName);
+	InstancedMeshComponent->SetCollisionEnabled(Key.CollisionEnabled);
+
+	for(int32 MaterialIndex = 0; MaterialIndex<Key.Materials.Num(); MaterialIndex++)
+	{
+		InstancedMeshComponent->SetMaterial(MaterialIndex,Key.Materials[MaterialIndex]);
+	}
+
+	//Added like a component added in the details panel, which is what exploding looks for
+	InstancedMeshComponent->CreationMethod = EComponentCreationMethod::Instance;
+
+	InstancedMeshActor->SetRootComponent(InstancedMeshComponent);
+	InstancedMeshActor->AddInstanceComponent(InstancedMeshComponent);
+	InstancedMeshComponent->SetWorldTransform(ActorTransform);
+	InstancedMeshComponent->RegisterComponent();
+
+	//One call for all instances, the tree is built once instead of per instance
+	InstancedMeshComponent->AddInstances(InstanceWorldTransforms,false,true);
+
+	InstancedMeshActor->Tags = Key.Tags;
+	InstancedMeshActor->SetActorLabel(ActorLabel);
+
+	return InstancedMeshActor;
+}
+
+void FInstancedMeshBuilder::GetExplodableComponents(AActor* Actor, TArray<UInstancedStaticMeshComponent*>& OutComponents)
+{
+	OutComponents.Reset();
+
+	//Foliage keeps its own instance data, emptying its components would delete the foliage of the level
+	if(!Actor || Actor->IsA<AInstancedFoliageActor>()) return;
+
+	TInlineComponentArray<UInstancedStaticMeshComponent*> InstancedMeshComponents(Actor);
+
+	for(UInstancedStaticMeshComponent* InstancedMeshComponent:InstancedMeshComponents)
+	{
+		//Components of the class or its construction script get their instances back on the next rerun
+		if(InstancedMeshComponent->CreationMethod != EComponentCreationMethod::Instance ||
+		InstancedMeshComponent->IsA<UFoliageInstancedStaticMeshComponent>() ||
+		!InstancedMeshComponent->GetStaticMesh())
+		{
+			continue;
+		}
+
+		OutComponents.Add(InstancedMeshComponent);
+	}
+}
+
+bool FInstancedMeshBuilder::IsBuiltInstancedMeshActor(const AActor* Actor)
+{
+	if(!Actor || Actor->GetClass() != AActor::StaticClass()) return false;
+
+	const UHierarchicalInstancedStaticMeshComponent* InstancedMeshComponent =
+	Cast<UHierarchicalInstancedStaticMeshComponent>(Actor->GetRootComponent());
+
+	return InstancedMeshComponent && InstancedMeshComponent->CreationMethod == EComponentCreationMethod::Instance &&
+	Actor->GetComponents().Num()==1;
+}
+
+void FInstancedMeshBuilder::ExplodeInstancedMeshActor(AActor* InstancedMeshActor, TArray<AActor*>& OutSpawnedActors)
+{
+	if(!InstancedMeshActor) return;
+
+	UWorld* World = InstancedMeshActor->GetWorld();
+
+	TArray<UInstancedStaticMeshComponent*> InstancedMeshComponents;
+	GetExplodableComponents(InstancedMeshActor,InstancedMeshComponents);
+
+	if(!World || InstancedMeshComponents.Num()==0) return;
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.ObjectFlags = RF_Transactional;
+	SpawnParameters.OverrideLevel = InstancedMeshActor->GetLevel();
+	SpawnParameters.bDeferConstruction = true;
+
+	for(UInstancedStaticMeshComponent* InstancedMeshComponent:InstancedMeshComponents)
+	{
+		UStaticMesh* StaticMesh = InstancedMeshComponent->GetStaticMesh();
+
+		for(int32 InstanceIndex = 0; InstanceIndex<InstancedMeshComponent->GetInstanceCount(); InstanceIndex++)
+		{
+			FTransform InstanceTransform;
+			InstancedMeshComponent->GetInstanceTransform(InstanceIndex,InstanceTransform,true);
+
+			//Construction is finished once the mesh is set, so render state is created only once
+			AStaticMeshActor* SpawnedActor = 
+			World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(),InstanceTransform,SpawnParameters);
+
+			if(!SpawnedActor) continue;
+
+			UStaticMeshComponent* StaticMeshComponent = SpawnedActor->GetStaticMeshComponent();
+			StaticMeshComponent->SetMobility(InstancedMeshComponent->Mobility);
+			StaticMeshComponent->SetStaticMesh(StaticMesh);
+
+			for(int32 MaterialIndex = 0; MaterialIndex<InstancedMeshComponent->GetNumMaterials(); MaterialIndex++)
+			{
+				StaticMeshComponent->SetMaterial(MaterialIndex,InstancedMeshComponent->GetMaterial(MaterialIndex));
+			}
+
+			StaticMeshComponent->SetCollisionProfileName(InstancedMeshComponent->GetCollisionProfileName());
+			StaticMeshComponent->SetCollisionEnabled(InstancedMeshComponent->GetCollisionEnabled());
+			StaticMeshComponent->SetCastShadow(InstancedMeshComponent->CastShadow);
+
+			SpawnedActor->Tags = InstancedMeshActor->Tags;
+			SpawnedActor->FinishSpawning(InstanceTransform);
+
+			OutSpawnedActors.Add(SpawnedActor);
+		}
+	}
+
+	if(IsBuiltInstancedMeshActor(InstancedMeshActor))
+	{
+		World->EditorDestroyActor(InstancedMeshActor,true);
+		return;
+	}
+
+	for(UInstancedStaticMeshComponent* InstancedMeshComponent:InstancedMeshComponents)
+	{
+		InstancedMeshComponent->Modify();
+		InstancedMeshComponent->ClearInstances();
+	}
+}
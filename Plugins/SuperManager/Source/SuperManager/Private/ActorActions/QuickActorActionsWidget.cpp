@@ -4,42 +4,74 @@
 #include "ActorActions/QuickActorActionsWidget.h"
 #include "Subsystems/EditorActorSubsystem.h"
 #include "DebugHeader.h"
+#include "SuperManager.h"
+#include "Engine/Selection.h"
+#include "Engine/StaticMeshActor.h"
+#include "ActorActions/InstancedMeshBuilder.h"
+#include "ScopedTransaction.h"
+#include "Async/ParallelFor.h"
+#include "Components/SplineComponent.h"
+#include "ActorActions/SurfaceScatter.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+
+//Exploding more instances than this asks first, every instance becomes an actor in the outliner
+static constexpr int32 ExplodeInstancesWithoutConfirmation = 1000;
 
 void UQuickActorActionsWidget::SelectAllActorsWithSimilarName()
 {
 	if(!GetEditorActorSubsystem()) return;
 
-	TArray<AActor*> SelectedActors = EditorActorSubsystem->GetSelectedLevelActors();
+	FString NameToSearch = LabelSearchPattern;
+	EActorLabelMatchMode MatchMode = EActorLabelMatchMode::EALMM_Prefix;
+	UWorld* WorldToSearch = GEditor->GetEditorWorldContext().World();
 	uint32 SelectionCounter = 0;
 
-	if(SelectedActors.Num()==0)
+	if(NameToSearch.IsEmpty())
 	{
-		DebugHeader::ShowNotifyInfo(TEXT("No actor selected"));
-		return;
-	}
+		TArray<AActor*> SelectedActors = EditorActorSubsystem->GetSelectedLevelActors();
 
-	if(SelectedActors.Num()>1)
-	{
-		DebugHeader::ShowNotifyInfo(TEXT("You can only select one actor"));
-		return;
-	}
+		if(SelectedActors.Num()==0)
+		{
+			DebugHeader::ShowNotifyInfo(TEXT("No actor selected"));
+			return;
+		}
 
-	FString SelectedActorName = SelectedActors[0]->GetActorLabel();
-	const FString NameToSearch = SelectedActorName.LeftChop(4);
+		if(SelectedActors.Num()>1)
+		{
+			DebugHeader::ShowNotifyInfo(TEXT("You can only select one actor"));
+			return;
+		}
 
-	TArray<AActor*> AllLeveActors = EditorActorSubsystem->GetAllLevelActors();
+		NameToSearch = FActorLabelIndex::StripNumericSuffix(SelectedActors[0]->GetActorLabel());
+		WorldToSearch = SelectedActors[0]->GetWorld();
 
-	for(AActor* ActorInLevel:AllLeveActors)
+		//A derived label is plain text that can span several words, searched as prefix or contained text
+		if(LabelMatchMode == E_LabelMatchMode::ELMM_Contains) MatchMode = EActorLabelMatchMode::EALMM_Contains;
+	}
+	else
 	{
-		if(!ActorInLevel) continue;
-
-		if(ActorInLevel->GetActorLabel().Contains(NameToSearch,SearchCase))
+		switch(LabelMatchMode)
 		{
-			EditorActorSubsystem->SetActorSelectionState(ActorInLevel,true);
-			SelectionCounter++;
+		case E_LabelMatchMode::ELMM_Token:		MatchMode = EActorLabelMatchMode::EALMM_Token;		break;
+		case E_LabelMatchMode::ELMM_Contains:	MatchMode = EActorLabelMatchMode::EALMM_Contains;	break;
+		case E_LabelMatchMode::ELMM_Glob:		MatchMode = EActorLabelMatchMode::EALMM_Glob;		break;
+		case E_LabelMatchMode::ELMM_Regex:		MatchMode = EActorLabelMatchMode::EALMM_Regex;		break;
+
+		default:
+			break;
 		}
 	}
 
+	FSuperManagerModule& SuperManagerModule =
+	FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+
+	TArray<AActor*> ActorsToSelect;
+	SuperManagerModule.GetActorLabelIndex().FindActors(WorldToSearch,NameToSearch,MatchMode,SearchCase,ActorsToSelect);
+
+	SelectionCounter = SelectActorsInBatch(ActorsToSelect);
+
 	if(SelectionCounter>0)
 	{
 		DebugHeader::ShowNotifyInfo(TEXT("Successfully selected ") + 
@@ -64,58 +96,487 @@ void UQuickActorActionsWidget::DuplicateActors()
 		return;
 	}
 
-	if(NumberOfDuplicates <=0 || OffsetDist == 0)
+	USplineComponent* PathSpline = nullptr;
+
+	if(DuplicationPattern == E_DuplicationPattern::EDP_Spline)
+	{
+		for(AActor* SelectedActor:SelectedActors)
+		{
+			if(!SelectedActor) continue;
+
+			PathSpline = SelectedActor->FindComponentByClass<USplineComponent>();
+
+			if(PathSpline)
+			{
+				SelectedActors.Remove(SelectedActor);
+				break;
+			}
+		}
+
+		if(!PathSpline)
+		{
+			DebugHeader::ShowNotifyInfo(TEXT("Select an actor with a spline to duplicate along"));
+			return;
+		}
+	}
+
+	//Final transforms of every copy are known before anything is spawned
+	TArray< TArray <FTransform> > DuplicateTransformsPerActor;
+	DuplicateTransformsPerActor.SetNum(SelectedActors.Num());
+
+	int32 NumOfDuplicates = 0;
+
+	for(int32 ActorIndex = 0; ActorIndex<SelectedActors.Num(); ActorIndex++)
+	{
+		if(!SelectedActors[ActorIndex]) continue;
+
+		GetDuplicationTransforms(SelectedActors[ActorIndex],PathSpline,DuplicateTransformsPerActor[ActorIndex]);
+		NumOfDuplicates += DuplicateTransformsPerActor[ActorIndex].Num();
+	}
+
+	if(NumOfDuplicates==0)
 	{
 		DebugHeader::ShowNotifyInfo(TEXT("Did not specify a number of duplications or an offset distance"));
 		return;
 	}
 
-	for(AActor* SelectedActor:SelectedActors)
-	{	
+	FScopedTransaction DuplicationTransaction(FText::FromString(TEXT("Duplicate Actors")));
+
+	TArray<AActor*> DuplicatedActors;
+	DuplicatedActors.Reserve(NumOfDuplicates);
+
+	//Copies of static mesh actors collected per mesh and materials, when duplicating as instances
+	TMap< FInstancedMeshKey, TArray <FTransform> > InstanceTransformsByMesh;
+	TMap< FInstancedMeshKey, UWorld* > WorldByMesh;
+
+	FDuplicateLabelCache LabelCache(GEditor->GetEditorWorldContext().World());
+
+	for(int32 ActorIndex = 0; ActorIndex<SelectedActors.Num(); ActorIndex++)
+	{
+		AActor* SelectedActor = SelectedActors[ActorIndex];
+		const TArray<FTransform>& DuplicateTransforms = DuplicateTransformsPerActor[ActorIndex];
+
 		if(!SelectedActor) continue;
 
-		for(int32 i = 0; i<NumberOfDuplicates; i++)
+		FInstancedMeshKey InstancedMeshKey;
+
+		if(bDuplicateAsInstances && 
+		FInstancedMeshBuilder::MakeKey(Cast<AStaticMeshActor>(SelectedActor),InstancedMeshKey))
+		{
+			InstanceTransformsByMesh.FindOrAdd(InstancedMeshKey).Append(DuplicateTransforms);
+			WorldByMesh.Add(InstancedMeshKey,SelectedActor->GetWorld());
+
+			Counter += DuplicateTransforms.Num();
+			continue;
+		}
+
+		for(const FTransform& DuplicateTransform:DuplicateTransforms)
 		{
-			AActor* DuplicatedActor = 
-			EditorActorSubsystem->DuplicateActor(SelectedActor,SelectedActor->GetWorld());
+			AActor* DuplicatedActor = SpawnDuplicateActor(SelectedActor,DuplicateTransform,LabelCache);
 
 			if(!DuplicatedActor) continue;
 
-			const float DuplicationOffsetDist = (i+1)*OffsetDist;
+			DuplicatedActors.Add(DuplicatedActor);
+			Counter++;
+		}		
+	}
+
+	for(const TPair<FInstancedMeshKey,TArray<FTransform>>& MeshInstances:InstanceTransformsByMesh)
+	{
+		const FString ActorLabel = GetUniqueLabel(MeshInstances.Key.StaticMesh->GetName() + TEXT("_Instances"),LabelCache);
+
+		if(AActor* InstancedMeshActor = FInstancedMeshBuilder::SpawnInstancedMeshActor(
+		WorldByMesh.FindChecked(MeshInstances.Key),MeshInstances.Key,MeshInstances.Value,ActorLabel))
+		{
+			DuplicatedActors.Add(InstancedMeshActor);
+		}
+	}
+
+	SelectActorsInBatch(DuplicatedActors);
+
+	if(Counter>0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("Successfully duplicated ")+
+		FString::FromInt(Counter)+TEXT(" actors"));
+	}
+}
+
+//Spawns the copy already at its final transform and finishes construction once,
+//instead of duplicating through copy and paste and moving the copy afterwards
+AActor* UQuickActorActionsWidget::SpawnDuplicateActor(AActor* SourceActor, const FTransform& DuplicateTransform, 
+FDuplicateLabelCache& LabelCache)
+{
+	UWorld* World = SourceActor->GetWorld();
 
-			switch(AxisForDuplication)
+	if(!World) return nullptr;
+
+	//Components added to the instance only are not carried over by a spawn template
+	if(SourceActor->GetInstanceComponents().Num()>0)
+	{
+		AActor* DuplicatedActor = EditorActorSubsystem->DuplicateActor(SourceActor,World);
+
+		if(DuplicatedActor)
+		{
+			DuplicatedActor->SetActorTransform(DuplicateTransform);
+			LabelCache.ExistingActorLabels.Add(DuplicatedActor->GetActorLabel());
+		}
+
+		return DuplicatedActor;
+	}
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.Template = SourceActor;
+	SpawnParameters.OverrideLevel = SourceActor->GetLevel();
+	SpawnParameters.ObjectFlags = RF_Transactional;
+	SpawnParameters.bDeferConstruction = true;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AActor* DuplicatedActor = World->SpawnActor(SourceActor->GetClass(),&DuplicateTransform,SpawnParameters);
+
+	if(!DuplicatedActor) return nullptr;
+
+	DuplicatedActor->FinishSpawning(DuplicateTransform);
+	DuplicatedActor->SetActorLabel(GetUniqueLabel(SourceActor->GetActorLabel(),LabelCache));
+
+	return DuplicatedActor;
+}
+
+//The label itself while no actor uses it, otherwise numbered like the editor does,
+//SM_Rock_01 -> SM_Rock_2, SM_Rock_3... The returned label is taken in the cache
+FString UQuickActorActionsWidget::GetUniqueLabel(const FString& Label, FDuplicateLabelCache& LabelCache) const
+{
+	if(!LabelCache.ExistingActorLabels.Contains(Label))
+	{
+		LabelCache.ExistingActorLabels.Add(Label);
+		return Label;
+	}
+
+	FString BaseLabel = Label;
+
+	int32 BaseLength = BaseLabel.Len();
+	while(BaseLength>0 && FChar::IsDigit(BaseLabel[BaseLength-1])) --BaseLength;
+
+	BaseLabel.LeftInline(BaseLength);
+
+	//Continues from the last number handed out, so labeling stays linear in the number of copies
+	int32& NextSuffix = LabelCache.NextSuffixByBaseLabel.FindOrAdd(BaseLabel,2);
+	FString CandidateLabel;
+
+	do
+	{
+		CandidateLabel = BaseLabel + FString::FromInt(NextSuffix++);
+	}
+	while(LabelCache.ExistingActorLabels.Contains(CandidateLabel));
+
+	LabelCache.ExistingActorLabels.Add(CandidateLabel);
+
+	return CandidateLabel;
+}
+
+void UQuickActorActionsWidget::GetDuplicationTransforms(const AActor* SourceActor, const USplineComponent* PathSpline,
+TArray<FTransform>& OutTransforms) const
+{
+	const FTransform SourceTransform = SourceActor->GetActorTransform();
+
+	switch(DuplicationPattern)
+	{
+	case E_DuplicationPattern::EDP_Linear:
+	{
+		if(NumberOfDuplicates<=0 || OffsetDist==0) return;
+
+		OutTransforms.Reserve(NumberOfDuplicates);
+
+		for(int32 i = 0; i<NumberOfDuplicates; i++)
+		{
+			FTransform DuplicateTransform = SourceTransform;
+			DuplicateTransform.AddToTranslation(GetDuplicationOffset(i));
+
+			OutTransforms.Add(DuplicateTransform);
+		}
+
+		return;
+	}
+
+	case E_DuplicationPattern::EDP_Grid:
+	{
+		if(GridCount.X<=0 || GridCount.Y<=0 || GridCount.Z<=0) return;
+
+		OutTransforms.Reserve(GridCount.X*GridCount.Y*GridCount.Z - 1);
+
+		for(int32 z = 0; z<GridCount.Z; z++)
+		{
+			for(int32 y = 0; y<GridCount.Y; y++)
 			{
-			case E_DuplicationAxis::EDA_XAxis:
+				for(int32 x = 0; x<GridCount.X; x++)
+				{
+					//First cell is the selected actor itself
+					if(x==0 && y==0 && z==0) continue;
 
-			DuplicatedActor->AddActorWorldOffset(FVector(DuplicationOffsetDist,0.f,0.f));
-				break;
+					FTransform DuplicateTransform = SourceTransform;
+					DuplicateTransform.AddToTranslation(FVector(x*GridSpacing.X,y*GridSpacing.Y,z*GridSpacing.Z));
 
-			case E_DuplicationAxis::EDA_YAxis:
+					OutTransforms.Add(DuplicateTransform);
+				}
+			}
+		}
 
-			DuplicatedActor->AddActorWorldOffset(FVector(0.f,DuplicationOffsetDist,0.f));
-				break;
+		return;
+	}
+
+	case E_DuplicationPattern::EDP_Radial:
+	{
+		if(RadialCount<=1 || RadialArcAngle==0) return;
 
-			case E_DuplicationAxis::EDA_ZAxis:
+		const FVector RingCenter = SourceTransform.GetLocation() - FVector(RadialRadius,0.f,0.f);
+		const FVector SourceOffset = SourceTransform.GetLocation() - RingCenter;
+		//The last actor of a full ring would sit on the selected actor, a partial arc ends at its angle
+		const float AngleStep = RadialArcAngle>=360.f ? RadialArcAngle/RadialCount : RadialArcAngle/(RadialCount-1);
 
-			DuplicatedActor->AddActorWorldOffset(FVector(0.f,0.f,DuplicationOffsetDist));
-				break;
+		OutTransforms.Reserve(RadialCount - 1);
 
-			case E_DuplicationAxis::EDA_MAX:
-				break;
+		for(int32 i = 1; i<RadialCount; i++)
+		{
+			const FQuat RingRotation(FVector::UpVector,FMath::DegreesToRadians(AngleStep*i));
 
-			default:
-				break;
+			FTransform DuplicateTransform = SourceTransform;
+			DuplicateTransform.SetLocation(RingCenter + RingRotation.RotateVector(SourceOffset));
+
+			if(bAlignCopiesToPattern)
+			{
+				DuplicateTransform.SetRotation(RingRotation*SourceTransform.GetRotation());
 			}
 
-			EditorActorSubsystem->SetActorSelectionState(DuplicatedActor,true);
+			OutTransforms.Add(DuplicateTransform);
+		}
+
+		return;
+	}
+
+	case E_DuplicationPattern::EDP_Spline:
+	{
+		if(!PathSpline || SplineCount<=0) return;
+
+		const float SplineLength = PathSpline->GetSplineLength();
+
+		//Closed loops would put the last copy on top of the first one
+		const int32 NumOfSegments = PathSpline->IsClosedLoop() ? SplineCount : FMath::Max(SplineCount-1,1);
+
+		OutTransforms.Reserve(SplineCount);
+
+		for(int32 i = 0; i<SplineCount; i++)
+		{
+			const float Distance = SplineLength*i/NumOfSegments;
+
+			FTransform DuplicateTransform = SourceTransform;
+			DuplicateTransform.SetLocation(
+			PathSpline->GetLocationAtDistanceAlongSpline(Distance,ESplineCoordinateSpace::World));
+
+			if(bAlignCopiesToPattern)
+			{
+				const FQuat SplineRotation = 
+				PathSpline->GetQuaternionAtDistanceAlongSpline(Distance,ESplineCoordinateSpace::World);
+
+				DuplicateTransform.SetRotation(SplineRotation*SourceTransform.GetRotation());
+			}
+
+			OutTransforms.Add(DuplicateTransform);
+		}
+
+		return;
+	}
+
+	default:
+		return;
+	}
+}
+
+void UQuickActorActionsWidget::ConvertSelectedActorsToInstances()
+{
+	if(!GetEditorActorSubsystem()) return;
+
+	TArray<AActor*> SelectedActors = EditorActorSubsystem->GetSelectedLevelActors();
+
+	TArray<AStaticMeshActor*> StaticMeshActors;
+
+	for(AActor* SelectedActor:SelectedActors)
+	{
+		if(AStaticMeshActor* StaticMeshActor = Cast<AStaticMeshActor>(SelectedActor))
+		{
+			StaticMeshActors.Add(StaticMeshActor);
+		}
+	}
+
+	if(StaticMeshActors.Num()==0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("No static mesh actor selected"));
+		return;
+	}
+
+	//Keys only read the actors, so they are built in parallel and grouped afterwards
+	TArray<FInstancedMeshKey> InstancedMeshKeys;
+	TArray<bool> HasInstancedMeshKey;
+	InstancedMeshKeys.SetNum(StaticMeshActors.Num());
+	HasInstancedMeshKey.SetNumZeroed(StaticMeshActors.Num());
+
+	ParallelFor(StaticMeshActors.Num(),[&](int32 ActorIndex)
+	{
+		HasInstancedMeshKey[ActorIndex] = FInstancedMeshBuilder::MakeKey(StaticMeshActors[ActorIndex],InstancedMeshKeys[ActorIndex]);
+	});
+
+	TMap< FInstancedMeshKey, TArray <AStaticMeshActor*> > ActorsByMesh;
+
+	for(int32 ActorIndex = 0; ActorIndex<StaticMeshActors.Num(); ActorIndex++)
+	{
+		if(HasInstancedMeshKey[ActorIndex])
+		{
+			ActorsByMesh.FindOrAdd(MoveTemp(InstancedMeshKeys[ActorIndex])).Add(StaticMeshActors[ActorIndex]);
+		}
+	}
+
+	FScopedTransaction ConversionTransaction(FText::FromString(TEXT("Convert Actors To Instances")));
+
+	TArray<AActor*> InstancedMeshActors;
+	uint32 Counter = 0;
+
+	FDuplicateLabelCache LabelCache(GEditor->GetEditorWorldContext().World());
+
+	for(const TPair<FInstancedMeshKey,TArray<AStaticMeshActor*>>& MeshActors:ActorsByMesh)
+	{
+		if(MeshActors.Value.Num()<MinActorsPerInstancedMesh) continue;
+
+		TArray<FTransform> InstanceTransforms;
+		InstanceTransforms.Reserve(MeshActors.Value.Num());
+
+		for(const AStaticMeshActor* StaticMeshActor:MeshActors.Value)
+		{
+			InstanceTransforms.Add(StaticMeshActor->GetActorTransform());
+		}
+
+		UWorld* World = MeshActors.Value[0]->GetWorld();
+
+		AActor* InstancedMeshActor = FInstancedMeshBuilder::SpawnInstancedMeshActor(World,MeshActors.Key,
+		InstanceTransforms,GetUniqueLabel(MeshActors.Key.StaticMesh->GetName() + TEXT("_Instances"),LabelCache));
+
+		if(!InstancedMeshActor) continue;
+
+		InstancedMeshActors.Add(InstancedMeshActor);
+
+		for(AStaticMeshActor* StaticMeshActor:MeshActors.Value)
+		{
+			World->EditorDestroyActor(StaticMeshActor,true);
 			Counter++;
-		}		
+		}
 	}
 
+	SelectActorsInBatch(InstancedMeshActors);
+
 	if(Counter>0)
 	{
-		DebugHeader::ShowNotifyInfo(TEXT("Successfully duplicated ")+
-		FString::FromInt(Counter)+TEXT(" actors"));
+		DebugHeader::ShowNotifyInfo(TEXT("Converted ") + FString::FromInt(Counter) + TEXT(" actors into ") 
+		+ FString::FromInt(InstancedMeshActors.Num()) + TEXT(" instanced meshes"));
+	}
+	else
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("No group of matching static mesh actors found"));
+	}
+}
+
+void UQuickActorActionsWidget::ExplodeSelectedInstancesToActors()
+{
+	if(!GetEditorActorSubsystem()) return;
+
+	TArray<AActor*> SelectedActors = EditorActorSubsystem->GetSelectedLevelActors();
+
+	if(SelectedActors.Num()==0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("No actor selected"));
+		return;
+	}
+
+	TArray<AActor*> ActorsToExplode;
+	int32 NumOfInstances = 0;
+	int32 NumOfSkippedActors = 0;
+
+	for(AActor* SelectedActor:SelectedActors)
+	{
+		TArray<UInstancedStaticMeshComponent*> ExplodableComponents;
+		FInstancedMeshBuilder::GetExplodableComponents(SelectedActor,ExplodableComponents);
+
+		if(ExplodableComponents.Num()==0)
+		{
+			NumOfSkippedActors++;
+			continue;
+		}
+
+		for(const UInstancedStaticMeshComponent* ExplodableComponent:ExplodableComponents)
+		{
+			NumOfInstances += ExplodableComponent->GetInstanceCount();
+		}
+
+		ActorsToExplode.Add(SelectedActor);
+	}
+
+	if(NumOfSkippedActors>0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("Skipped ") + FString::FromInt(NumOfSkippedActors) + 
+		TEXT(" actors, foliage and instances from Blueprints are not exploded"));
+	}
+
+	if(NumOfInstances>ExplodeInstancesWithoutConfirmation)
+	{
+		const EAppReturnType::Type ConfirmResult = DebugHeader::ShowMsgDialog(EAppMsgType::YesNo,
+		TEXT("This spawns ") + FString::FromInt(NumOfInstances) + TEXT(" actors. Continue?"),false);
+
+		if(ConfirmResult==EAppReturnType::No) return;
+	}
+
+	FScopedTransaction ExplodeTransaction(FText::FromString(TEXT("Explode Instances To Actors")));
+
+	TArray<AActor*> SpawnedActors;
+
+	for(AActor* ActorToExplode:ActorsToExplode)
+	{
+		FInstancedMeshBuilder::ExplodeInstancedMeshActor(ActorToExplode,SpawnedActors);
+	}
+
+	FDuplicateLabelCache LabelCache(GEditor->GetEditorWorldContext().World());
+
+	for(AActor* SpawnedActor:SpawnedActors)
+	{
+		const UStaticMesh* StaticMesh = CastChecked<AStaticMeshActor>(SpawnedActor)->GetStaticMeshComponent()->GetStaticMesh();
+
+		SpawnedActor->SetActorLabel(GetUniqueLabel(StaticMesh->GetName(),LabelCache));
+	}
+
+	SelectActorsInBatch(SpawnedActors);
+
+	if(SpawnedActors.Num()>0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("Successfully spawned ") + FString::FromInt(SpawnedActors.Num()) + TEXT(" actors"));
+	}
+	else if(NumOfSkippedActors==0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("No instanced mesh selected"));
+	}
+}
+
+FVector UQuickActorActionsWidget::GetDuplicationOffset(int32 DuplicateIndex) const
+{
+	const float DuplicationOffsetDist = (DuplicateIndex+1)*OffsetDist;
+
+	switch(AxisForDuplication)
+	{
+	case E_DuplicationAxis::EDA_XAxis:
+		return FVector(DuplicationOffsetDist,0.f,0.f);
+
+	case E_DuplicationAxis::EDA_YAxis:
+		return FVector(0.f,DuplicationOffsetDist,0.f);
+
+	case E_DuplicationAxis::EDA_ZAxis:
+		return FVector(0.f,0.f,DuplicationOffsetDist);
+
+	default:
+		return FVector::ZeroVector;
 	}
 }
 
@@ -145,52 +606,255 @@ void UQuickActorActionsWidget::RandomizeActorTransform()
 		return;
 	}
 
-	for(AActor* SelectedActor:SelectedActors)
+	const int32 BaseSeed = bUseFixedSeed ? RandomSeed : FMath::Rand();
+
+	TArray<FTransform> RandomizedTransforms;
+	RandomizedTransforms.SetNum(SelectedActors.Num());
+
+	//Only reads the actors, every new transform is computed before any actor is moved
+	ParallelFor(SelectedActors.Num(),[&](int32 ActorIndex)
 	{
+		const AActor* SelectedActor = SelectedActors[ActorIndex];
+
+		if(!SelectedActor) return;
+
+		//Seeded by the actor name, stable between editor sessions unlike the name index
+		FRandomStream RandomStream(static_cast<int32>(
+		HashCombine(static_cast<uint32>(BaseSeed),FCrc::StrCrc32(*SelectedActor->GetName()))));
+
+		RandomizedTransforms[ActorIndex] = GetRandomizedTransform(SelectedActor->GetActorTransform(),RandomStream);
+	});
+
+	FScopedTransaction RandomizeTransaction(FText::FromString(TEXT("Randomize Actor Transform")));
+
+	for(int32 ActorIndex = 0; ActorIndex<SelectedActors.Num(); ActorIndex++)
+	{
+		AActor* SelectedActor = SelectedActors[ActorIndex];
+
 		if(!SelectedActor) continue;
 
-		if(RandomActorRotation.bRandomizeRotYaw)
+		SelectedActor->Modify();
+		SelectedActor->SetActorTransform(RandomizedTransforms[ActorIndex]);
+
+		Counter++;
+	}
+
+	if(Counter>0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("Successfully set ")+
+		FString::FromInt(Counter)+TEXT(" actors"));
+	}
+
+}
+
+//Rotations are applied in world space in yaw, pitch, roll order, same as adding them to the actor one by one
+FTransform UQuickActorActionsWidget::GetRandomizedTransform(const FTransform& SourceTransform, FRandomStream& RandomStream) const
+{
+	FTransform RandomizedTransform = SourceTransform;
+	FQuat RandomizedRotation = SourceTransform.GetRotation();
+
+	if(RandomActorRotation.bRandomizeRotYaw)
+	{
+		const float RandomRotYawValue = RandomStream.FRandRange(RandomActorRotation.RotYawMin,RandomActorRotation.RotYawMax);
+
+		RandomizedRotation = FRotator(0.f,RandomRotYawValue,0.f).Quaternion()*RandomizedRotation;
+	}
+
+	if(RandomActorRotation.bRandomizeRotPitch)
+	{
+		const float RandomRotPitchValue = RandomStream.FRandRange(RandomActorRotation.RotPitchMin,RandomActorRotation.RotPitchMax);
+
+		RandomizedRotation = FRotator(RandomRotPitchValue,0.f,0.f).Quaternion()*RandomizedRotation;
+	}
+
+	if(RandomActorRotation.bRandomizeRotRoll)
+	{
+		const float RandomRotRollValue = RandomStream.FRandRange(RandomActorRotation.RotRollMin,RandomActorRotation.RotRollMax);
+
+		RandomizedRotation = FRotator(0.f,0.f,RandomRotRollValue).Quaternion()*RandomizedRotation;
+	}
+
+	RandomizedTransform.SetRotation(RandomizedRotation);
+
+	if(bRandomizeScale)
+	{
+		RandomizedTransform.SetScale3D(FVector(RandomStream.FRandRange(ScaleMin,ScaleMax)));
+	}
+
+	if(bRandomizeOffset)
+	{
+		//X and Y are drawn separately so offsets do not line up along a diagonal
+		const float RandomOffsetX = RandomStream.FRandRange(OffsetMin,OffsetMax);
+		const float RandomOffsetY = RandomStream.FRandRange(OffsetMin,OffsetMax);
+
+		RandomizedTransform.AddToTranslation(FVector(RandomOffsetX,RandomOffsetY,0.f));
+	}
+
+	return RandomizedTransform;
+}
+
+void UQuickActorActionsWidget::ScatterSelectedActors()
+{
+	if(!GetEditorActorSubsystem()) return;
+
+	TArray<AActor*> SelectedActors = EditorActorSubsystem->GetSelectedLevelActors();
+	SelectedActors.Remove(nullptr);
+
+	if(SelectedActors.Num()==0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("No actor selected"));
+		return;
+	}
+
+	UWorld* World = SelectedActors[0]->GetWorld();
+
+	TArray<FTransform> SourceTransforms;
+	TArray<const AActor*> IgnoredActors;
+	FVector ScatterCenter = FVector::ZeroVector;
+
+	for(AActor* SelectedActor:SelectedActors)
+	{
+		SourceTransforms.Add(SelectedActor->GetActorTransform());
+		IgnoredActors.Add(SelectedActor);
+		ScatterCenter += SelectedActor->GetActorLocation();
+	}
+
+	ScatterCenter /= SelectedActors.Num();
+
+	FSurfaceScatterSettings ScatterSettings;
+	ScatterSettings.Region = FBox2D(
+	FVector2D(ScatterCenter) - ScatterAreaSize*0.5f,FVector2D(ScatterCenter) + ScatterAreaSize*0.5f);
+	ScatterSettings.TraceTopZ = ScatterCenter.Z + ScatterTraceHeight;
+	ScatterSettings.TraceBottomZ = ScatterCenter.Z - ScatterTraceHeight;
+	ScatterSettings.MinDistance = ScatterMinDistance;
+	ScatterSettings.MaxPoints = ScatterCount;
+	ScatterSettings.Seed = ScatterSeed;
+	ScatterSettings.TraceChannel = ScatterTraceChannel;
+	ScatterSettings.bAlignToSurfaceNormal = bAlignToSurfaceNormal;
+	ScatterSettings.MaxSlopeAngle = ScatterMaxSlopeAngle;
+	ScatterSettings.bRandomizeYaw = bRandomizeScatterYaw;
+
+	if(ScatterSettings.MinDistance<=0.f || ScatterAreaSize.X<=0.f || ScatterAreaSize.Y<=0.f)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("Did not specify a scatter area or a minimum distance"));
+		return;
+	}
+
+	TArray<FSurfaceScatterPoint> ScatterPoints;
+	FString ErrorMessage;
+
+	if(!FSurfaceScatter::Scatter(World,ScatterSettings,SourceTransforms,IgnoredActors,ScatterPoints,ErrorMessage))
+	{
+		if(!ErrorMessage.IsEmpty())
 		{
-			const float RandomRotYawValue = FMath::RandRange(RandomActorRotation.RotYawMin,RandomActorRotation.RotYawMax);
-			
-			SelectedActor->AddActorWorldRotation(FRotator(0.f,RandomRotYawValue,0.f));
+			DebugHeader::ShowMsgDialog(EAppMsgType::Ok,ErrorMessage);
 		}
 
-		if(RandomActorRotation.bRandomizeRotPitch)
-		{
-			const float RandomRotPitchValue = FMath::RandRange(RandomActorRotation.RotPitchMin,RandomActorRotation.RotPitchMax);
+		return;
+	}
 
-			SelectedActor->AddActorWorldRotation(FRotator(RandomRotPitchValue,0.f,0.f));
-		}
+	if(ScatterPoints.Num()==0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("No surface found to scatter on"));
+		return;
+	}
 
-		if(RandomActorRotation.bRandomizeRotRoll)
-		{
-			const float RandomRotRollValue = FMath::RandRange(RandomActorRotation.RotRollMin,RandomActorRotation.RotRollMax);
+	//Key per source, sources without a static mesh to instance are spawned as actors
+	TArray<FInstancedMeshKey> SourceMeshKeys;
+	TArray<bool> IsSourceInstanced;
+	SourceMeshKeys.SetNum(SelectedActors.Num());
+	IsSourceInstanced.SetNumZeroed(SelectedActors.Num());
 
-			SelectedActor->AddActorWorldRotation(FRotator(0.f,0.f,RandomRotRollValue));
+	if(bScatterAsInstances)
+	{
+		for(int32 SourceIndex = 0; SourceIndex<SelectedActors.Num(); SourceIndex++)
+		{
+			IsSourceInstanced[SourceIndex] = 
+			FInstancedMeshBuilder::MakeKey(Cast<AStaticMeshActor>(SelectedActors[SourceIndex]),SourceMeshKeys[SourceIndex]);
 		}
+	}
+
+	FScopedTransaction ScatterTransaction(FText::FromString(TEXT("Scatter Actors")));
+
+	TArray<AActor*> ScatteredActors;
+	TMap< FInstancedMeshKey, TArray <FTransform> > InstanceTransformsByMesh;
+	uint32 Counter = 0;
+
+	FDuplicateLabelCache LabelCache(World);
 
-		if(bRandomizeScale)
+	for(const FSurfaceScatterPoint& ScatterPoint:ScatterPoints)
+	{
+		if(IsSourceInstanced[ScatterPoint.SourceIndex])
 		{
-			SelectedActor->SetActorScale3D(FVector(FMath::RandRange(ScaleMin,ScaleMax)));
+			InstanceTransformsByMesh.FindOrAdd(SourceMeshKeys[ScatterPoint.SourceIndex]).Add(ScatterPoint.Transform);
+			Counter++;
+			continue;
 		}
 
-		if(bRandomizeOffset)
+		if(AActor* ScatteredActor = SpawnDuplicateActor(SelectedActors[ScatterPoint.SourceIndex],ScatterPoint.Transform,LabelCache))
 		{
-			const float RandomOffsetValue = FMath::RandRange(OffsetMin,OffsetMax);
+			ScatteredActors.Add(ScatteredActor);
+			Counter++;
+		}
+	}
 
-			SelectedActor->AddActorWorldOffset(FVector(RandomOffsetValue,RandomOffsetValue,0.f));
+	for(const TPair<FInstancedMeshKey,TArray<FTransform>>& MeshInstances:InstanceTransformsByMesh)
+	{
+		const FString ActorLabel = GetUniqueLabel(MeshInstances.Key.StaticMesh->GetName() + TEXT("_Scatter"),LabelCache);
+
+		if(AActor* InstancedMeshActor = 
+		FInstancedMeshBuilder::SpawnInstancedMeshActor(World,MeshInstances.Key,MeshInstances.Value,ActorLabel))
+		{
+			ScatteredActors.Add(InstancedMeshActor);
 		}
+	}
 
-		Counter++;
+	SelectActorsInBatch(ScatteredActors);
+
+	DebugHeader::ShowNotifyInfo(TEXT("Successfully scattered ")+
+	FString::FromInt(Counter)+TEXT(" copies"));
+}
+
+//Selects the actors in one batch operation, the editor and listeners get a single selection change
+//notification instead of one per actor. Returns the number of actors selected
+uint32 UQuickActorActionsWidget::SelectActorsInBatch(const TArray<AActor*>& ActorsToSelect)
+{
+	FSuperManagerModule& SuperManagerModule =
+	FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+
+	USelection* ActorSelection = GEditor->GetSelectedActors();
+	uint32 SelectionCounter = 0;
+
+	//Locked actors would be deselected again by the selection lock, they are left out here once
+	//and the lock's per actor handler is skipped while the batch selects the rest
+	TArray<AActor*> UnlockedActorsToSelect;
+	UnlockedActorsToSelect.Reserve(ActorsToSelect.Num());
+
+	for(AActor* ActorToSelect:ActorsToSelect)
+	{
+		if(!ActorToSelect || SuperManagerModule.CheckIsActorSelectionLocked(ActorToSelect)) continue;
+
+		UnlockedActorsToSelect.Add(ActorToSelect);
 	}
 
-	if(Counter>0)
+	SuperManagerModule.BeginActorSelectionBatch();
+
+	ActorSelection->BeginBatchSelectOperation();
+	ActorSelection->Modify();
+
+	for(AActor* ActorToSelect:UnlockedActorsToSelect)
 	{
-		DebugHeader::ShowNotifyInfo(TEXT("Successfully set ")+
-		FString::FromInt(Counter)+TEXT(" actors"));
+		GEditor->SelectActor(ActorToSelect,true,false,true);
+		SelectionCounter++;
 	}
 
+	ActorSelection->EndBatchSelectOperation(false);
+
+	SuperManagerModule.EndActorSelectionBatch();
+
+	GEditor->NoteSelectionChange();
+
+	return SelectionCounter;
 }
 
 bool UQuickActorActionsWidget::GetEditorActorSubsystem()
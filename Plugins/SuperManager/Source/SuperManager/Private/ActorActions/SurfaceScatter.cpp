@@ -0,0 +1,252 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ActorActions/SurfaceScatter.h"
+#include "Engine/World.h"
+#include "CollisionQueryParams.h"
+#include "Async/ParallelFor.h"
+#include "Misc/ScopedSlowTask.h"
+
+//Candidates tried around an active point before it is retired
+static constexpr int32 PoissonCandidatesPerPoint = 30;
+
+//Limit for the sampling grid. The working distance grows with the region, so only a huge
+//number of requested points in a region that can barely hold them comes close to it
+static constexpr int64 MaxPoissonGridCells = 4*1024*1024;
+
+//A filled Bridson sampling places about 0.7 points per squared distance of area
+static constexpr float PoissonPointsPerSquaredDistance = 0.7f;
+
+//The working distance is picked so the region holds about this many times the requested points,
+//a random subset of the filled region is kept
+static constexpr float PoissonOversampling = 1.5f;
+
+//Active list iterations between progress updates and cancel checks
+static constexpr int32 PoissonProgressInterval = 4096;
+
+//Number of traces every parallel task runs
+static constexpr int32 TraceChunkSize = 64;
+
+bool FSurfaceScatter::GeneratePoissonPoints(const FBox2D& Region, float MinDistance, int32 MaxPoints,
+FRandomStream& RandomStream, TArray<FVector2D>& OutPoints, FString& OutErrorMessage)
+{
+	OutPoints.Reset();
+
+	if(!Region.bIsValid || MinDistance<=0.f || MaxPoints<=0) return false;
+
+	const FVector2D RegionSize = Region.GetSize();
+
+	//Sampling grows outward from the first point, so it has to fill the whole region to cover it.
+	//When the region holds far more points than requested, the distance is raised until a filled
+	//region holds only a few more, so the work follows the requested count and not the area
+	const float RegionArea = RegionSize.X*RegionSize.Y;
+	const float CountBasedDistance = FMath::Sqrt(RegionArea*PoissonPointsPerSquaredDistance/(MaxPoints*PoissonOversampling));
+
+	MinDistance = FMath::Max(MinDistance,CountBasedDistance);
+
+	//With this cell size a cell can hold at most one point
+	const float CellSize = MinDistance/UE_SQRT_2;
+	const int32 GridWidth = FMath::Max(FMath::CeilToInt(RegionSize.X/CellSize),1);
+	const int32 GridHeight = FMath::Max(FMath::CeilToInt(RegionSize.Y/CellSize),1);
+
+	if(static_cast<int64>(GridWidth)*GridHeight > MaxPoissonGridCells)
+	{
+		OutErrorMessage = TEXT("Too many copies for the scatter area, lower the count or increase the distance");
+		return false;
+	}
+
+	TArray<int32> Grid;
+	Grid.Init(INDEX_NONE,GridWidth*GridHeight);
+
+	TArray<int32> ActivePoints;
+
+	const float MinDistanceSquared = MinDistance*MinDistance;
+
+	auto GetCellCoords = [&](const FVector2D& Point)
+	{
+		return FIntPoint(
+		FMath::Clamp(FMath::FloorToInt((Point.X - Region.Min.X)/CellSize),0,GridWidth-1),
+		FMath::Clamp(FMath::FloorToInt((Point.Y - Region.Min.Y)/CellSize),0,GridHeight-1));
+	};
+
+	auto AddPoint = [&](const FVector2D& Point)
+	{
+		const FIntPoint Cell = GetCellCoords(Point);
+		const int32 PointIndex = OutPoints.Add(Point);
+
+		Grid[Cell.Y*GridWidth + Cell.X] = PointIndex;
+		ActivePoints.Add(PointIndex);
+	};
+
+	auto IsFarEnough = [&](const FVector2D& Candidate)
+	{
+		const FIntPoint Cell = GetCellCoords(Candidate);
+
+		//Points closer than the distance can only be two cells away
+		for(int32 y = FMath::Max(Cell.Y-2,0); y<=FMath::Min(Cell.Y+2,GridHeight-1); y++)
+		{
+			for(int32 x = FMath::Max(Cell.X-2,0); x<=FMath::Min(Cell.X+2,GridWidth-1); x++)
+			{
+				const int32 NeighbourIndex = Grid[y*GridWidth + x];
+
+				if(NeighbourIndex!=INDEX_NONE &&
+				FVector2D::DistSquared(OutPoints[NeighbourIndex],Candidate) < MinDistanceSquared)
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	};
+
+	const int32 ExpectedNumOfPoints = FMath::Max(FMath::CeilToInt(RegionArea*PoissonPointsPerSquaredDistance/(MinDistance*MinDistance)),1);
+
+	FScopedSlowTask SamplingTask(ExpectedNumOfPoints,FText::FromString(TEXT("Spreading scatter points")));
+	SamplingTask.MakeDialogDelayed(0.5f,true);
+
+	int32 NumOfReportedPoints = 0;
+	int32 Iteration = 0;
+
+	AddPoint(Region.Min + FVector2D(RandomStream.FRand()*RegionSize.X,RandomStream.FRand()*RegionSize.Y));
+
+	while(ActivePoints.Num()>0)
+	{
+		if(++Iteration % PoissonProgressInterval == 0)
+		{
+			if(SamplingTask.ShouldCancel())
+			{
+				OutPoints.Reset();
+				return false;
+			}
+
+			const int32 NumOfNewPoints = FMath::Min(OutPoints.Num(),ExpectedNumOfPoints) - NumOfReportedPoints;
+			SamplingTask.EnterProgressFrame(NumOfNewPoints);
+			NumOfReportedPoints += NumOfNewPoints;
+		}
+
+		const int32 ActiveIndex = RandomStream.RandHelper(ActivePoints.Num());
+		const FVector2D ActivePoint = OutPoints[ActivePoints[ActiveIndex]];
+
+		bool bFoundCandidate = false;
+
+		for(int32 Attempt = 0; Attempt<PoissonCandidatesPerPoint; Attempt++)
+		{
+			//Candidates come from the ring between one and two times the distance
+			const float Angle = RandomStream.FRandRange(0.f,2.f*PI);
+			const float Radius = MinDistance*FMath::Sqrt(RandomStream.FRandRange(1.f,4.f));
+
+			const FVector2D Candidate = ActivePoint + FVector2D(FMath::Cos(Angle),FMath::Sin(Angle))*Radius;
+
+			if(!Region.IsInside(Candidate) || !IsFarEnough(Candidate)) continue;
+
+			AddPoint(Candidate);
+			bFoundCandidate = true;
+			break;
+		}
+
+		if(!bFoundCandidate)
+		{
+			ActivePoints.RemoveAtSwap(ActiveIndex,1,false);
+		}
+	}
+
+	if(OutPoints.Num()>MaxPoints)
+	{
+		//Partial shuffle, the few points dropped are spread over the whole region
+		for(int32 PointIndex = 0; PointIndex<MaxPoints; PointIndex++)
+		{
+			OutPoints.Swap(PointIndex,PointIndex + RandomStream.RandHelper(OutPoints.Num()-PointIndex));
+		}
+
+		OutPoints.SetNum(MaxPoints);
+	}
+
+	return true;
+}
+
+void FSurfaceScatter::ProjectPointsToSurface(UWorld* World, const TArray<FVector2D>& Points,
+const FSurfaceScatterSettings& Settings, const TArray<FTransform>& SourceTransforms,
+const TArray<const AActor*>& IgnoredActors, TArray<FSurfaceScatterPoint>& OutScatterPoints)
+{
+	OutScatterPoints.Reset();
+
+	if(!World || SourceTransforms.Num()==0) return;
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SuperManagerSurfaceScatter),true);
+	QueryParams.AddIgnoredActors(IgnoredActors);
+
+	const float MinSurfaceUpDot = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(Settings.MaxSlopeAngle,0.f,90.f)));
+
+	TArray<FSurfaceScatterPoint> ScatterPoints;
+	ScatterPoints.SetNum(Points.Num());
+
+	const int32 NumOfChunks = FMath::DivideAndRoundUp(Points.Num(),TraceChunkSize);
+
+	//Scene queries only read the physics scene, so the traces of all points run side by side
+	ParallelFor(NumOfChunks,[&](int32 ChunkIndex)
+	{
+		const int32 ChunkStart = ChunkIndex*TraceChunkSize;
+		const int32 ChunkEnd = FMath::Min(ChunkStart+TraceChunkSize,Points.Num());
+
+		for(int32 PointIndex = ChunkStart; PointIndex<ChunkEnd; PointIndex++)
+		{
+			const FVector2D& Point = Points[PointIndex];
+
+			FHitResult HitResult;
+
+			const bool bHit = World->LineTraceSingleByChannel(HitResult,
+			FVector(Point.X,Point.Y,Settings.TraceTopZ),FVector(Point.X,Point.Y,Settings.TraceBottomZ),
+			Settings.TraceChannel,QueryParams);
+
+			if(!bHit || FVector::DotProduct(HitResult.ImpactNormal,FVector::UpVector) < MinSurfaceUpDot) continue;
+
+			//Every point has its own stream, the result does not depend on how the chunks are scheduled
+			FRandomStream PointRandomStream(static_cast<int32>(HashCombine(static_cast<uint32>(Settings.Seed),PointIndex)));
+
+			const int32 SourceIndex = PointRandomStream.RandHelper(SourceTransforms.Num());
+			const FTransform& SourceTransform = SourceTransforms[SourceIndex];
+
+			FQuat Rotation = SourceTransform.GetRotation();
+
+			if(Settings.bRandomizeYaw)
+			{
+				Rotation = FQuat(FVector::UpVector,PointRandomStream.FRandRange(0.f,2.f*PI))*Rotation;
+			}
+
+			if(Settings.bAlignToSurfaceNormal)
+			{
+				Rotation = FQuat::FindBetweenNormals(FVector::UpVector,HitResult.ImpactNormal)*Rotation;
+			}
+
+			ScatterPoints[PointIndex].Transform = FTransform(Rotation,HitResult.ImpactPoint,SourceTransform.GetScale3D());
+			ScatterPoints[PointIndex].SourceIndex = SourceIndex;
+		}
+	});
+
+	OutScatterPoints.Reserve(ScatterPoints.Num());
+
+	for(const FSurfaceScatterPoint& ScatterPoint:ScatterPoints)
+	{
+		if(ScatterPoint.SourceIndex!=INDEX_NONE)
+		{
+			OutScatterPoints.Add(ScatterPoint);
+		}
+	}
+}
+
+bool FSurfaceScatter::Scatter(UWorld* World, const FSurfaceScatterSettings& Settings, const TArray<FTransform>& SourceTransforms,
+const TArray<const AActor*>& IgnoredActors, TArray<FSurfaceScatterPoint>& OutScatterPoints, FString& OutErrorMessage)
+{
+	FRandomStream RandomStream(Settings.Seed);
+	TArray<FVector2D> Points;
+
+	//The error message stays empty when the user cancelled
+	if(!GeneratePoissonPoints(Settings.Region,Settings.MinDistance,Settings.MaxPoints,RandomStream,Points,OutErrorMessage))
+	{
+		return false;
+	}
+
+	ProjectPointsToSurface(World,Points,Settings,SourceTransforms,IgnoredActors,OutScatterPoints);
+
+	return true;
+}
@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetActions/AssetNameAllocator.h"
+#include "AssetRegistryModule.h"
+
+TArray<FString> FAssetNameAllocator::AllocateSuffixedNames(const FName& PackagePath, const FString& BaseName, 
+int32 NumOfNames)
+{
+	TArray<FString> AllocatedNames;
+	AllocatedNames.Reserve(NumOfNames);
+
+	int32& NextSuffix = NextSuffixByBaseName.FindOrAdd(PackagePath.ToString() / BaseName,1);
+
+	while(AllocatedNames.Num()<NumOfNames)
+	{
+		const FString CandidateName = BaseName + TEXT("_") + FString::FromInt(NextSuffix++);
+
+		if(IsNameUsed(PackagePath,CandidateName)) continue;
+
+		ReserveName(PackagePath,CandidateName);
+		AllocatedNames.Add(CandidateName);
+	}
+
+	return AllocatedNames;
+}
+
+bool FAssetNameAllocator::IsNameUsed(const FName& PackagePath, const FString& AssetName) const
+{
+	const FName PackageName = MakePackageName(PackagePath,AssetName);
+
+	if(ReservedPackageNames.Contains(PackageName)) return true;
+
+	//Created but not yet known to the registry
+	if(FindPackage(nullptr,*PackageName.ToString())) return true;
+
+	IAssetRegistry& AssetRegistry =
+	FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	TArray<FAssetData> AssetsInPackage;
+	AssetRegistry.GetAssetsByPackageName(PackageName,AssetsInPackage);
+
+	return AssetsInPackage.Num()>0;
+}
+
+void FAssetNameAllocator::ReserveName(const FName& PackagePath, const FString& AssetName)
+{
+	ReservedPackageNames.Add(MakePackageName(PackagePath,AssetName));
+}
+
+FName FAssetNameAllocator::MakePackageName(const FName& PackagePath, const FString& AssetName)
+{
+	return FName(*(PackagePath.ToString() / AssetName));
+}
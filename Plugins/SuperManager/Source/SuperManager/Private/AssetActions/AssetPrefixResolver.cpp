@@ -0,0 +1,127 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetActions/AssetPrefixResolver.h"
+#include "CustomSettings/SuperManagerSettings.h"
+#include "AssetRegistryModule.h"
+
+FAssetPrefixResolver& FAssetPrefixResolver::Get()
+{
+	static FAssetPrefixResolver PrefixResolver;
+
+	return PrefixResolver;
+}
+
+void FAssetPrefixResolver::Initialize()
+{
+	ObjectsReinstancedHandle = 
+	FCoreUObjectDelegates::OnObjectsReinstanced.AddRaw(this,&FAssetPrefixResolver::OnObjectsReinstanced);
+}
+
+void FAssetPrefixResolver::Shutdown()
+{
+	FCoreUObjectDelegates::OnObjectsReinstanced.Remove(ObjectsReinstancedHandle);
+
+	ResolvedPrefixes.Empty();
+	NativeParentClassesByClassName.Empty();
+}
+
+//Only fired by recompiles and hot reload, the results are cheap to rebuild
+void FAssetPrefixResolver::OnObjectsReinstanced(const TMap<UObject*,UObject*>& OldToNewInstanceMap)
+{
+	ResolvedPrefixes.Empty();
+	NativeParentClassesByClassName.Empty();
+}
+
+FName FAssetPrefixResolver::GetClassPathName(const UClass* Class)
+{
+	return FName(*Class->GetPathName());
+}
+
+const FString* FAssetPrefixResolver::FindPrefix(const UClass* AssetClass)
+{
+	if(!AssetClass) return nullptr;
+
+	RebuildRulesIfOutdated();
+
+	const FName AssetClassPathName = GetClassPathName(AssetClass);
+
+	if(const FString* CachedPrefix = ResolvedPrefixes.Find(AssetClassPathName))
+	{
+		return CachedPrefix->IsEmpty() ? nullptr : CachedPrefix;
+	}
+
+	//Walk up to the closest class that has a rule
+	FString ResolvedPrefix;
+
+	for(const UClass* ClassToCheck = AssetClass; ClassToCheck; ClassToCheck = ClassToCheck->GetSuperClass())
+	{
+		const FName ClassPathName = ClassToCheck==AssetClass ? AssetClassPathName : GetClassPathName(ClassToCheck);
+
+		if(const FString* PrefixFound = PrefixRules.Find(ClassPathName))
+		{
+			ResolvedPrefix = *PrefixFound;
+			break;
+		}
+	}
+
+	const FString& CachedPrefix = ResolvedPrefixes.Add(AssetClassPathName,ResolvedPrefix);
+
+	return CachedPrefix.IsEmpty() ? nullptr : &CachedPrefix;
+}
+
+const UClass* FAssetPrefixResolver::ResolveAssetClass(const FAssetData& AssetData)
+{
+	if(const UClass* AssetClass = AssetData.GetClass()) return AssetClass;
+
+	if(const UClass** CachedNativeParentClass = NativeParentClassesByClassName.Find(AssetData.AssetClass))
+	{
+		return *CachedNativeParentClass;
+	}
+
+	IAssetRegistry& AssetRegistry =
+	FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	//Built from the ParentClass tags of the Blueprint assets, closest parent first
+	TArray<FName> AncestorClassNames;
+	AssetRegistry.GetAncestorClassNames(AssetData.AssetClass,AncestorClassNames);
+
+	const UClass* NativeParentClass = nullptr;
+
+	for(const FName& AncestorClassName:AncestorClassNames)
+	{
+		//Only native classes are cached, they are never garbage collected
+		const UClass* AncestorClass = FindObject<UClass>(ANY_PACKAGE,*AncestorClassName.ToString());
+
+		if(AncestorClass && AncestorClass->HasAnyClassFlags(CLASS_Native))
+		{
+			NativeParentClass = AncestorClass;
+			break;
+		}
+	}
+
+	NativeParentClassesByClassName.Add(AssetData.AssetClass,NativeParentClass);
+
+	return NativeParentClass;
+}
+
+void FAssetPrefixResolver::RebuildRulesIfOutdated()
+{
+	const USuperManagerSettings* SuperManagerSettings = GetDefault<USuperManagerSettings>();
+
+	if(CachedRulesRevision == SuperManagerSettings->GetPrefixRulesRevision()) return;
+
+	CachedRulesRevision = SuperManagerSettings->GetPrefixRulesRevision();
+
+	PrefixRules.Empty();
+	ResolvedPrefixes.Empty();
+
+	//Rules stay soft paths, a rule for a class of a module that is not loaded yet
+	//matches as soon as assets of that class show up
+	for(const TPair<TSoftClassPtr<UObject>,FString>& PrefixRule:SuperManagerSettings->AssetPrefixes)
+	{
+		if(!PrefixRule.Key.IsNull())
+		{
+			PrefixRules.Add(FName(*PrefixRule.Key.ToSoftObjectPath().GetAssetPathString()),PrefixRule.Value);
+		}
+	}
+}
@@ -0,0 +1,182 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetActions/NamingConventionAudit.h"
+#include "AssetActions/AssetPrefixResolver.h"
+#include "AssetRegistryModule.h"
+#include "AssetToolsModule.h"
+#include "Async/ParallelFor.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopedSlowTask.h"
+#include "SuperManager.h"
+#include "DebugHeader.h"
+
+void FNamingConventionAudit::FindViolations(const TArray<FString>& FolderPathsToAudit, 
+TArray<FNamingViolation>& OutViolations)
+{
+	OutViolations.Empty();
+
+	IAssetRegistry& AssetRegistry =
+	FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	FARFilter Filter;
+	Filter.bRecursivePaths = true;
+
+	for(const FString& FolderPathToAudit:FolderPathsToAudit)
+	{
+		Filter.PackagePaths.Emplace(*FolderPathToAudit);
+	}
+
+	TArray<FAssetData> AssetsToAudit;
+	AssetRegistry.GetAssets(Filter,AssetsToAudit);
+
+	//Resolve every distinct class once on this thread, the parallel pass only reads the result
+	TMap<FName, FString> PrefixByClassName;
+	TMap<FName, const UClass*> ClassByClassName;
+	FAssetPrefixResolver& PrefixResolver = FAssetPrefixResolver::Get();
+
+	for(const FAssetData& AssetToAudit:AssetsToAudit)
+	{
+		if(PrefixByClassName.Contains(AssetToAudit.AssetClass)) continue;
+
+		//Blueprint generated classes that are not loaded resolve to their native parent
+		const UClass* AssetClass = PrefixResolver.ResolveAssetClass(AssetToAudit);
+		const FString* PrefixFound = PrefixResolver.FindPrefix(AssetClass);
+
+		if(!AssetClass)
+		{
+			DebugHeader::PrintLog(TEXT("Naming convention audit could not resolve class ") + 
+			AssetToAudit.AssetClass.ToString() + TEXT(", its assets are not checked"));
+		}
+
+		PrefixByClassName.Add(AssetToAudit.AssetClass,PrefixFound ? *PrefixFound : FString());
+		ClassByClassName.Add(AssetToAudit.AssetClass,AssetClass);
+	}
+
+	FSuperManagerModule& SuperManagerModule =
+	FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+
+	const int32 NumOfChunks = FMath::DivideAndRoundUp(AssetsToAudit.Num(),AuditChunkSize);
+
+	TArray< TArray <FNamingViolation> > ViolationsPerChunk;
+	ViolationsPerChunk.SetNum(NumOfChunks);
+
+	ParallelFor(NumOfChunks,[&](int32 ChunkIndex)
+	{
+		const int32 ChunkStart = ChunkIndex*AuditChunkSize;
+		const int32 ChunkEnd = FMath::Min(ChunkStart+AuditChunkSize,AssetsToAudit.Num());
+
+		for(int32 AssetIndex = ChunkStart; AssetIndex<ChunkEnd; AssetIndex++)
+		{
+			const FAssetData& AssetToAudit = AssetsToAudit[AssetIndex];
+			const FString& ExpectedPrefix = PrefixByClassName.FindChecked(AssetToAudit.AssetClass);
+
+			if(ExpectedPrefix.IsEmpty()) continue;
+
+			const FString AssetName = AssetToAudit.AssetName.ToString();
+
+			if(AssetName.StartsWith(ExpectedPrefix)) continue;
+
+			if(!SuperManagerModule.ShouldListAssetPath(AssetToAudit.PackagePath.ToString())) continue;
+
+			FNamingViolation& Violation = ViolationsPerChunk[ChunkIndex].AddDefaulted_GetRef();
+			Violation.AssetData = AssetToAudit;
+			Violation.ExpectedPrefix = ExpectedPrefix;
+			Violation.SuggestedName = MakePrefixedName(AssetName,ExpectedPrefix,ClassByClassName.FindChecked(AssetToAudit.AssetClass));
+		}
+	});
+
+	for(TArray<FNamingViolation>& ChunkViolations:ViolationsPerChunk)
+	{
+		OutViolations.Append(MoveTemp(ChunkViolations));
+	}
+}
+
+FString FNamingConventionAudit::MakePrefixedName(FString AssetName, const FString& Prefix, const UClass* AssetClass)
+{
+	if(AssetClass && AssetClass->IsChildOf<UMaterialInstanceConstant>())
+	{
+		AssetName.RemoveFromStart(TEXT("M_"));
+		AssetName.RemoveFromEnd(TEXT("_Inst"));
+	}
+
+	return Prefix + AssetName;
+}
+
+uint32 FNamingConventionAudit::FixViolations(const TArray<FNamingViolation>& ViolationsToFix)
+{
+	TArray<FAssetRenameData> AssetsToRename;
+	AssetsToRename.Reserve(ViolationsToFix.Num());
+
+	for(const FNamingViolation& ViolationToFix:ViolationsToFix)
+	{
+		const FSoftObjectPath OldObjectPath(ViolationToFix.AssetData.ObjectPath);
+		const FSoftObjectPath NewObjectPath(ViolationToFix.AssetData.PackagePath.ToString() / ViolationToFix.SuggestedName + 
+		TEXT(".") + ViolationToFix.SuggestedName);
+
+		AssetsToRename.Emplace(OldObjectPath,NewObjectPath);
+	}
+
+	return RenameAssetsInBatches(AssetsToRename);
+}
+
+uint32 FNamingConventionAudit::RenameAssetsInBatches(const TArray<FAssetRenameData>& AssetsToRename)
+{
+	if(AssetsToRename.Num()==0) return 0;
+
+	FAssetToolsModule& AssetToolsModule =
+	FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
+
+	uint32 Counter = 0;
+
+	FScopedSlowTask RenameTask(AssetsToRename.Num(),FText::FromString(TEXT("Renaming assets")));
+	RenameTask.MakeDialog();
+
+	for(int32 BatchStart = 0; BatchStart<AssetsToRename.Num(); BatchStart += RenameBatchSize)
+	{
+		const int32 BatchNum = FMath::Min<int32>(RenameBatchSize,AssetsToRename.Num()-BatchStart);
+
+		RenameTask.EnterProgressFrame(BatchNum);
+
+		TArray<FAssetRenameData> RenameBatch(AssetsToRename.GetData()+BatchStart,BatchNum);
+
+		AssetToolsModule.Get().RenameAssets(RenameBatch);
+
+		//The call reports failure for the whole batch if any rename failed, so count every asset found
+		//under its new path. Checked before garbage collection while the renamed assets are still loaded
+		for(const FAssetRenameData& RenameData:RenameBatch)
+		{
+			if(RenameData.NewObjectPath.ResolveObject())
+			{
+				++Counter;
+			}
+		}
+
+		//Release what the batch pulled in before loading the next one
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	return Counter;
+}
+
+FString FNamingConventionAudit::WriteReport(const TArray<FNamingViolation>& Violations)
+{
+	TArray<FString> ReportLines;
+	ReportLines.Reserve(Violations.Num()+1);
+	ReportLines.Add(TEXT("ObjectPath,Class,ExpectedPrefix,SuggestedName"));
+
+	for(const FNamingViolation& Violation:Violations)
+	{
+		ReportLines.Add(FString::Printf(TEXT("%s,%s,%s,%s"),
+		*Violation.AssetData.ObjectPath.ToString(),
+		*Violation.AssetData.AssetClass.ToString(),
+		*Violation.ExpectedPrefix,
+		*Violation.SuggestedName));
+	}
+
+	const FString ReportFilePath = FPaths::ProjectSavedDir() / TEXT("SuperManager") / TEXT("NamingConventionAudit.csv");
+
+	FFileHelper::SaveStringArrayToFile(ReportLines,*ReportFilePath);
+
+	return ReportFilePath;
+}
@@ -2,12 +2,17 @@
 
 
 #include "AssetActions/QuickAssetAction.h"
+#include "AssetActions/AssetNameAllocator.h"
+#include "AssetActions/AssetPrefixResolver.h"
+#include "AssetActions/NamingConventionAudit.h"
 #include "DebugHeader.h"
 #include "EditorUtilityLibrary.h"
 #include "EditorAssetLibrary.h"
 #include "ObjectTools.h"
 #include "AssetRegistryModule.h"
 #include "AssetToolsModule.h"
+#include "FileHelpers.h"
+#include "Misc/ScopedSlowTask.h"
 
 void UQuickAssetAction::DuplicateAssets(int32 NumOfDuplicates)
 {
@@ -20,22 +25,53 @@ void UQuickAssetAction::DuplicateAssets(int32 NumOfDuplicates)
 	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
 	uint32 Counter = 0;
 
+	FAssetToolsModule& AssetToolsModule =
+	FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
+
+	TArray<UPackage*> PackagesToSave;
+
+	//Reads every target folder once and hands out free suffixes for the whole batch
+	FAssetNameAllocator NameAllocator;
+
+	FScopedSlowTask DuplicationTask(SelectedAssetsData.Num()*NumOfDuplicates,
+	FText::FromString(TEXT("Duplicating assets")));
+	DuplicationTask.MakeDialog(true);
+
 	for(const FAssetData& SelectedAssetData:SelectedAssetsData)
 	{
-		for(int32 i = 0; i<NumOfDuplicates; i++)
+		//Checked before the source is loaded, so cancelling does not load the remaining assets
+		if(DuplicationTask.ShouldCancel()) break;
+
+		//Resolve the source once, every copy is duplicated from the object already in memory
+		UObject* SourceAsset = SelectedAssetData.GetAsset();
+
+		if(!SourceAsset) continue;
+
+		const FString PackagePath = SelectedAssetData.PackagePath.ToString();
+
+		const TArray<FString> NewDuplicatedAssetNames = NameAllocator.AllocateSuffixedNames(
+		SelectedAssetData.PackagePath,SelectedAssetData.AssetName.ToString(),NumOfDuplicates);
+
+		for(const FString& NewDuplicatedAssetName:NewDuplicatedAssetNames)
 		{
-			const FString SourceAssetPath = SelectedAssetData.ObjectPath.ToString();
-			const FString NewDuplicatedAssetName = SelectedAssetData.AssetName.ToString() + TEXT("_") + FString::FromInt(i+1);
-			const FString NewPathName = FPaths::Combine(SelectedAssetData.PackagePath.ToString(),NewDuplicatedAssetName);
+			if(DuplicationTask.ShouldCancel()) break;
+
+			DuplicationTask.EnterProgressFrame();
 
-			if(UEditorAssetLibrary::DuplicateAsset(SourceAssetPath, NewPathName))
-			{	
-				UEditorAssetLibrary::SaveAsset(NewPathName,false);
+			if(UObject* DuplicatedAsset = AssetToolsModule.Get().DuplicateAsset(NewDuplicatedAssetName,PackagePath,SourceAsset))
+			{
+				PackagesToSave.Add(DuplicatedAsset->GetOutermost());
 				++Counter;
 			}
 		}
 	}
 
+	//Single save pass for all new packages instead of a save per copy
+	if(PackagesToSave.Num()>0)
+	{
+		UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave,false);
+	}
+
 	if(Counter>0)
 	{	
 		DebugHeader::ShowNotifyInfo(TEXT("Successfully duplicated " + FString::FromInt(Counter) + " files"));
@@ -45,22 +81,26 @@ void UQuickAssetAction::DuplicateAssets(int32 NumOfDuplicates)
 
 void UQuickAssetAction::AddPrefixes()
 {
-	TArray<UObject*>SelectedObjects = UEditorUtilityLibrary::GetSelectedAssets();
-	uint32 Counter = 0;
+	//Asset data only, class and name come from the registry so nothing is loaded to resolve prefixes
+	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
+	TArray<FAssetRenameData> AssetsToRename;
 
-	for(UObject* SelectedObject:SelectedObjects)
-	{
-		if(!SelectedObject) continue;
+	FAssetPrefixResolver& PrefixResolver = FAssetPrefixResolver::Get();
+	TSet<FString> ClassNamesWithoutPrefix;
 
-		FString* PrefixFound = PrefixMap.Find(SelectedObject->GetClass());
+	for(const FAssetData& SelectedAssetData:SelectedAssetsData)
+	{
+		//Blueprint generated classes that are not loaded resolve to their native parent
+		const UClass* SelectedAssetClass = PrefixResolver.ResolveAssetClass(SelectedAssetData);
+		const FString* PrefixFound = PrefixResolver.FindPrefix(SelectedAssetClass);
 
-		if(!PrefixFound||PrefixFound->IsEmpty())
+		if(!PrefixFound)
 		{
-			DebugHeader::Print(TEXT("Failed to find prefix for class ") + SelectedObject->GetClass()->GetName(),FColor::Red);
+			ClassNamesWithoutPrefix.Add(SelectedAssetData.AssetClass.ToString());
 			continue;
 		}
 
-		FString OldName = SelectedObject->GetName();
+		const FString OldName = SelectedAssetData.AssetName.ToString();
 
 		if(OldName.StartsWith(*PrefixFound))
 		{
@@ -68,19 +108,24 @@ void UQuickAssetAction::AddPrefixes()
 			continue;
 		}
 
-		if(SelectedObject->IsA<UMaterialInstanceConstant>())
-		{
-			OldName.RemoveFromStart(TEXT("M_"));
-			OldName.RemoveFromEnd(TEXT("_Inst"));
-		}
+		const FString NewNameWithPrefix = FNamingConventionAudit::MakePrefixedName(OldName,*PrefixFound,SelectedAssetClass);
 
-		const FString NewNameWithPrefix = *PrefixFound + OldName;
+		//Rename through soft object paths, only the rename itself loads the asset
+		const FSoftObjectPath OldObjectPath(SelectedAssetData.ObjectPath);
+		const FSoftObjectPath NewObjectPath(SelectedAssetData.PackagePath.ToString() / NewNameWithPrefix + 
+		TEXT(".") + NewNameWithPrefix);
 
-		UEditorUtilityLibrary::RenameAsset(SelectedObject,NewNameWithPrefix);
+		AssetsToRename.Emplace(OldObjectPath,NewObjectPath);
+	}
 
-		++Counter;
+	//One message per class instead of one per asset
+	for(const FString& ClassNameWithoutPrefix:ClassNamesWithoutPrefix)
+	{
+		DebugHeader::Print(TEXT("Failed to find prefix for class ") + ClassNameWithoutPrefix,FColor::Red);
 	}
 
+	const uint32 Counter = FNamingConventionAudit::RenameAssetsInBatches(AssetsToRename);
+
 	if(Counter>0)
 	{
 		DebugHeader::ShowNotifyInfo(TEXT("Successfully renamed "+FString::FromInt(Counter)+" assets"));
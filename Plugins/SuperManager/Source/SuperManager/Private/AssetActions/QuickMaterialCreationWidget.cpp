@@ -4,16 +4,30 @@
 #include "AssetActions/QuickMaterialCreationWidget.h"
 #include "DebugHeader.h"
 #include "EditorUtilityLibrary.h"
-#include "EditorAssetLibrary.h"
 #include "AssetToolsModule.h"
 #include "Factories/MaterialFactoryNew.h"
 #include "Materials/MaterialInstanceConstant.h"
 #include "Factories/MaterialInstanceConstantFactoryNew.h"
+#include "MaterialShared.h"
+#include "AssetActions/AssetNameAllocator.h"
+#include "AssetActions/TextureChannelPacker.h"
+#include "AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "FileHelpers.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Engine/Texture2D.h"
+#include "Engine/AssetManager.h"
 
 #pragma region QuickMaterialCreationCore
 	
 void UQuickMaterialCreationWidget::CreateMaterialFromSelectedTextures()
 {
+	if(SelectedTexturesLoadHandle.IsValid() && SelectedTexturesLoadHandle->IsLoadingInProgress())
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok,TEXT("Still loading the textures of the previous material"));
+		return;
+	}
+
 	if(bCustomMaterialName)
 	{
 		if(MaterialName.IsEmpty() || MaterialName.Equals(TEXT("M_")))
@@ -24,15 +38,103 @@ void UQuickMaterialCreationWidget::CreateMaterialFromSelectedTextures()
 	}
 
 	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
-	TArray<UTexture2D*> SelectedTexturesArray;
+	TArray<FSoftObjectPath> SelectedTexturePaths;
 	FString SelectedTextureFolderPath;
-	uint32 PinsConnectedCounter = 0;
 
-	if(!ProcessSelectedData(SelectedAssetsData, SelectedTexturesArray, SelectedTextureFolderPath)) {MaterialName = TEXT("M_"); return;}
+	if(!ProcessSelectedData(SelectedAssetsData, SelectedTexturePaths, SelectedTextureFolderPath)) {MaterialName = TEXT("M_"); return;}
 	
-	if(CheckIsNameUsed(SelectedTextureFolderPath, MaterialName)) {MaterialName = TEXT("M_"); return;}
+	FAssetNameAllocator NameAllocator;
+	FString UsedName;
+
+	if(!ReserveMaterialNames(NameAllocator,SelectedTextureFolderPath,MaterialName,UsedName))
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok,UsedName + TEXT(" is already used by asset"));
+		MaterialName = TEXT("M_");
+		return;
+	}
+
+	FMaterialCreationRequest CreationRequest;
+	CreationRequest.MaterialName = MaterialName;
+	CreationRequest.FolderPath = SelectedTextureFolderPath;
+	CreationRequest.ChannelPackingType = ChannelPackingType;
+	CreationRequest.bUseMasterMaterial = bUseMasterMaterial;
+	CreationRequest.bCreateMaterialInstance = bCreateMaterialInstance;
+
+	//Only the confirmed textures are loaded, in one async request so the editor stays responsive
+	SelectedTexturesLoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(SelectedTexturePaths,
+	FStreamableDelegate::CreateUObject(this,&UQuickMaterialCreationWidget::OnSelectedTexturesLoaded,
+	SelectedTexturePaths,CreationRequest));
+
+	MaterialName = TEXT("M_");
+}
+
+void UQuickMaterialCreationWidget::OnSelectedTexturesLoaded(TArray<FSoftObjectPath> LoadedTexturePaths, 
+FMaterialCreationRequest CreationRequest)
+{
+	SelectedTexturesLoadHandle.Reset();
+
+	TArray<UTexture2D*> SelectedTexturesArray;
+	uint32 PinsConnectedCounter = 0;
+
+	for(const FSoftObjectPath& LoadedTexturePath:LoadedTexturePaths)
+	{
+		if(UTexture2D* LoadedTexture = Cast<UTexture2D>(LoadedTexturePath.ResolveObject()))
+		{
+			SelectedTexturesArray.Add(LoadedTexture);
+		}
+	}
+
+	//Classify all textures in one pass each before any asset or node is created
+	const FTextureRoleClassifier TextureRoleClassifier = CompileTextureRoleClassifier();
+	TArray< TPair <UTexture2D*, ETextureRole> > ClassifiedTextures;
+
+	for(UTexture2D* SelectedTexture:SelectedTexturesArray)
+	{
+		if(!SelectedTexture) continue;
+
+		FTextureRoleMatch TextureRoleMatch;
+
+		if(!TextureRoleClassifier.Classify(SelectedTexture->GetName(),TextureRoleMatch))
+		{
+			DebugHeader::Print(TEXT("No supported texture name found in: ") + SelectedTexture->GetName(),FColor::Red);
+			continue;
+		}
+
+		ClassifiedTextures.Emplace(SelectedTexture,TextureRoleMatch.Role);
+	}
+
+	if(ClassifiedTextures.Num()==0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok,TEXT("None of the selected textures matches a supported texture name"));
+		return;
+	}
+
+	if(CreationRequest.ChannelPackingType == E_ChannelPackingType::ECPT_ORM)
+	{
+		FString PackedTextureName = CreationRequest.MaterialName;
+		PackedTextureName.RemoveFromStart(TEXT("M_"));
+		PackedTextureName = TEXT("T_") + PackedTextureName + TEXT("_ORM");
+
+		FAssetNameAllocator NameAllocator;
+		PackSeparateMasksIntoORM(ClassifiedTextures,CreationRequest.FolderPath,PackedTextureName,NameAllocator);
+	}
 
-	UMaterial* CreatedMaterial = CreateMaterialAsset(MaterialName,SelectedTextureFolderPath);
+	if(CreationRequest.bUseMasterMaterial)
+	{
+		//No new material and no new shaders, only an instance with the textures assigned
+		UMaterialInterface* LoadedMasterMaterial = LoadMasterMaterial();
+
+		if(LoadedMasterMaterial && 
+		CreateMaterialInstanceAsset(LoadedMasterMaterial,CreationRequest.MaterialName,CreationRequest.FolderPath,ClassifiedTextures))
+		{
+			DebugHeader::ShowNotifyInfo(TEXT("Successfully created instance of ") + LoadedMasterMaterial->GetName());
+		}
+
+		TextureSettingsBatch.Apply();
+		return;
+	}
+
+	UMaterial* CreatedMaterial = CreateMaterialAsset(CreationRequest.MaterialName,CreationRequest.FolderPath);
 
 	if(!CreatedMaterial)
 	{
@@ -40,20 +142,39 @@ void UQuickMaterialCreationWidget::CreateMaterialFromSelectedTextures()
 		return;
 	}
 
-	for(UTexture2D* SelectedTexture:SelectedTexturesArray)
+	CreateMaterialNodesForTextures(CreatedMaterial,ClassifiedTextures,CreationRequest.ChannelPackingType,PinsConnectedCounter);
+
+	TextureSettingsBatch.Apply();
+
+	RecompileMaterials({CreatedMaterial});
+
+	if(PinsConnectedCounter>0)
 	{
-		if(!SelectedTexture) continue;
+		DebugHeader::ShowNotifyInfo(TEXT("Successfully connected ") 
+		+ FString::FromInt(PinsConnectedCounter) + (TEXT(" pins")));
+	}
 
-		switch(ChannelPackingType)
+	if(CreationRequest.bCreateMaterialInstance)
+	{
+		CreateMaterialInstanceAsset(CreatedMaterial,CreationRequest.MaterialName,CreationRequest.FolderPath);
+	}
+}
+
+void UQuickMaterialCreationWidget::CreateMaterialNodesForTextures(UMaterial* CreatedMaterial, 
+const TArray<TPair<UTexture2D*, ETextureRole>>& ClassifiedTextures, E_ChannelPackingType PackingType, uint32& PinsConnectedCounter)
+{
+	for(const TPair<UTexture2D*,ETextureRole>& ClassifiedTexture:ClassifiedTextures)
+	{
+		switch(PackingType)
 		{
 		case E_ChannelPackingType::ECPT_NoChannelPacking:
 
-			Default_CreateMaterialNodes(CreatedMaterial,SelectedTexture,PinsConnectedCounter);
+			Default_CreateMaterialNodes(CreatedMaterial,ClassifiedTexture.Key,ClassifiedTexture.Value,PinsConnectedCounter);
 			break;
 
 		case E_ChannelPackingType::ECPT_ORM:
 
-			ORM_CreateMaterialNodes(CreatedMaterial,SelectedTexture,PinsConnectedCounter);
+			ORM_CreateMaterialNodes(CreatedMaterial,ClassifiedTexture.Key,ClassifiedTexture.Value,PinsConnectedCounter);
 			break;
 
 		case E_ChannelPackingType::ECPT_MAX:
@@ -63,24 +184,93 @@ void UQuickMaterialCreationWidget::CreateMaterialFromSelectedTextures()
 			break;
 		}		
 	}
+}
 
-	if(PinsConnectedCounter>0)
+//Replaces separate AO, roughness and metallic textures with one packed ORM texture,
+//returns the packed texture or null when the set already has an ORM texture or nothing to pack
+UTexture2D* UQuickMaterialCreationWidget::PackSeparateMasksIntoORM(TArray<TPair<UTexture2D*, ETextureRole>>& InOutClassifiedTextures, 
+const FString& PackagePath, const FString& PackedTextureName, FAssetNameAllocator& NameAllocator)
+{
+	UTexture2D* MaskTextures[3] = {nullptr,nullptr,nullptr};
+
+	for(const TPair<UTexture2D*,ETextureRole>& ClassifiedTexture:InOutClassifiedTextures)
 	{
-		DebugHeader::ShowNotifyInfo(TEXT("Successfully connected ") 
-		+ FString::FromInt(PinsConnectedCounter) + (TEXT(" pins")));
+		switch(ClassifiedTexture.Value)
+		{
+		case ETextureRole::ETR_ORM:
+			return nullptr;
+
+		case ETextureRole::ETR_AmbientOcclusion:
+			MaskTextures[0] = ClassifiedTexture.Key;
+			break;
+
+		case ETextureRole::ETR_Roughness:
+			MaskTextures[1] = ClassifiedTexture.Key;
+			break;
+
+		case ETextureRole::ETR_Metallic:
+			MaskTextures[2] = ClassifiedTexture.Key;
+			break;
+
+		default:
+			break;
+		}
 	}
 
-	if(bCreateMaterialInstance)
+	if(!MaskTextures[0] && !MaskTextures[1] && !MaskTextures[2]) return nullptr;
+
+	const FName PackagePathName(*PackagePath);
+
+	if(NameAllocator.IsNameUsed(PackagePathName,PackedTextureName))
 	{
-		CreateMaterialInstanceAsset(CreatedMaterial,MaterialName,SelectedTextureFolderPath);
+		DebugHeader::Print(PackedTextureName + TEXT(" is already used by asset, textures not packed"),FColor::Red);
+		return nullptr;
 	}
 
-	MaterialName = TEXT("M_");
+	FString ErrorMessage;
+	UTexture2D* PackedTexture = 
+	FTextureChannelPacker::PackORM(MaskTextures[0],MaskTextures[1],MaskTextures[2],PackagePath,PackedTextureName,ErrorMessage);
+
+	if(!PackedTexture)
+	{
+		DebugHeader::Print(TEXT("Failed to pack ") + PackedTextureName + TEXT(": ") + ErrorMessage,FColor::Red);
+		return nullptr;
+	}
+
+	NameAllocator.ReserveName(PackagePathName,PackedTextureName);
+
+	InOutClassifiedTextures.RemoveAll([](const TPair<UTexture2D*,ETextureRole>& ClassifiedTexture)
+	{
+		return ClassifiedTexture.Value == ETextureRole::ETR_AmbientOcclusion ||
+		ClassifiedTexture.Value == ETextureRole::ETR_Roughness ||
+		ClassifiedTexture.Value == ETextureRole::ETR_Metallic;
+	});
+
+	InOutClassifiedTextures.Emplace(PackedTexture,ETextureRole::ETR_ORM);
+
+	return PackedTexture;
+}
+
+//Materials are wired without recompiling, this triggers a single recompile per material in one update context
+void UQuickMaterialCreationWidget::RecompileMaterials(const TArray<UMaterial*>& MaterialsToRecompile)
+{
+	FMaterialUpdateContext MaterialUpdateContext;
+
+	for(UMaterial* MaterialToRecompile:MaterialsToRecompile)
+	{
+		if(!MaterialToRecompile) continue;
+
+		MaterialToRecompile->PreEditChange(nullptr);
+		MaterialToRecompile->PostEditChange();
+
+		MaterialUpdateContext.AddMaterial(MaterialToRecompile);
+	}
 }
 
-//Process the selected data, will filter out textures,and return false if non-texture selected
+//Process the selected data, will filter out textures,and return false if non-texture selected.
+//Classes are checked on the registry data, so a wrong selection is rejected before anything gets loaded
 bool UQuickMaterialCreationWidget::ProcessSelectedData(const TArray<FAssetData>& SelectedDataToProccess, 
-TArray<UTexture2D*>& OutSelectedTexturesArray, FString& OutSelectedTexturePackagePath)
+TArray<FSoftObjectPath>& OutSelectedTexturePaths, FString& OutSelectedTexturePackagePath)
 {
 	if(SelectedDataToProccess.Num()==0)
 	{
@@ -92,21 +282,17 @@ TArray<UTexture2D*>& OutSelectedTexturesArray, FString& OutSelectedTexturePackag
 
 	for(const FAssetData& SelectedData:SelectedDataToProccess)
 	{
-		UObject* SelectedAsset = SelectedData.GetAsset();
-
-		if(!SelectedAsset) continue;
+		const UClass* SelectedAssetClass = SelectedData.GetClass();
 
-		UTexture2D* SelectedTexture = Cast<UTexture2D>(SelectedAsset);
-
-		if(!SelectedTexture)
+		if(!SelectedAssetClass || !SelectedAssetClass->IsChildOf(UTexture2D::StaticClass()))
 		{
 			DebugHeader::ShowMsgDialog(EAppMsgType::Ok,TEXT("Please select only textures\n") + 
-			SelectedAsset->GetName() + TEXT(" is not a texture"));
+			SelectedData.AssetName.ToString() + TEXT(" is not a texture"));
 
 			return false;
 		}
 
-		OutSelectedTexturesArray.Add(SelectedTexture);
+		OutSelectedTexturePaths.Add(SelectedData.ToSoftObjectPath());
 
 		if(OutSelectedTexturePackagePath.IsEmpty())
 		{
@@ -115,7 +301,7 @@ TArray<UTexture2D*>& OutSelectedTexturesArray, FString& OutSelectedTexturePackag
 
 		if(!bCustomMaterialName && !bMaterialNameSet)
 		{
-			MaterialName = SelectedAsset->GetName();
+			MaterialName = SelectedData.AssetName.ToString();
 			MaterialName.RemoveFromStart(TEXT("T_"));
 			MaterialName.InsertAt(0,TEXT("M_"));
 
@@ -126,27 +312,65 @@ TArray<UTexture2D*>& OutSelectedTexturesArray, FString& OutSelectedTexturePackag
 	return true;
 }
 
-//Will return true if the material name is used by asset under the specified folder
-bool UQuickMaterialCreationWidget::CheckIsNameUsed(const FString& FolderPathToCheck, 
-const FString& MaterialNameToCheck)
+//Checks and reserves every name the material creation will use, the material and/or its instance.
+//Returns false with the first name already taken
+bool UQuickMaterialCreationWidget::ReserveMaterialNames(FAssetNameAllocator& NameAllocator, 
+const FString& FolderPath, const FString& NameOfTheMaterial, FString& OutUsedName)
 {
-	TArray<FString> ExistingAssetsPaths = UEditorAssetLibrary::ListAssets(FolderPathToCheck,false);
+	const FName PackagePath(*FolderPath);
+
+	TArray<FString, TInlineAllocator<2>> NamesToReserve;
 
-	for(const FString& ExistingAssetPath:ExistingAssetsPaths)
+	//With a master material only the instance gets created
+	if(!bUseMasterMaterial)
 	{
-		const FString ExistingAssetName = FPaths::GetBaseFilename(ExistingAssetPath);
+		NamesToReserve.Add(NameOfTheMaterial);
+	}
 
-		if(ExistingAssetName.Equals(MaterialNameToCheck))
-		{
-			DebugHeader::ShowMsgDialog(EAppMsgType::Ok,MaterialNameToCheck + 
-			TEXT(" is already used by asset"));
+	if(bUseMasterMaterial || bCreateMaterialInstance)
+	{
+		NamesToReserve.Add(MakeMaterialInstanceName(NameOfTheMaterial));
+	}
 
-			return true;
+	for(const FString& NameToReserve:NamesToReserve)
+	{
+		if(NameAllocator.IsNameUsed(PackagePath,NameToReserve))
+		{
+			OutUsedName = NameToReserve;
+			return false;
 		}
 	}
 
-	return false;
+	for(const FString& NameToReserve:NamesToReserve)
+	{
+		NameAllocator.ReserveName(PackagePath,NameToReserve);
+	}
+
+	return true;
+}
+
+FString UQuickMaterialCreationWidget::MakeMaterialInstanceName(FString NameOfTheMaterial)
+{
+	NameOfTheMaterial.RemoveFromStart(TEXT("M_"));
+	NameOfTheMaterial.InsertAt(0,TEXT("MI_"));
+
+	return NameOfTheMaterial;
+}
+
+FTextureRoleClassifier UQuickMaterialCreationWidget::CompileTextureRoleClassifier() const
+{
+	FTextureRoleClassifier TextureRoleClassifier;
+
+	TextureRoleClassifier.AddPatterns(ETextureRole::ETR_BaseColor,BaseColorArray);
+	TextureRoleClassifier.AddPatterns(ETextureRole::ETR_Metallic,MetallicArray);
+	TextureRoleClassifier.AddPatterns(ETextureRole::ETR_Roughness,RoughnessArray);
+	TextureRoleClassifier.AddPatterns(ETextureRole::ETR_Normal,NormalArray);
+	TextureRoleClassifier.AddPatterns(ETextureRole::ETR_AmbientOcclusion,AmbientOcclusionArray);
+	TextureRoleClassifier.AddPatterns(ETextureRole::ETR_ORM,ORMArray);
+
+	TextureRoleClassifier.Compile(bIgnoreCaseInTextureNames,bMatchWholeTokensOnly);
 
+	return TextureRoleClassifier;
 }
 
 UMaterial * UQuickMaterialCreationWidget::CreateMaterialAsset(const FString & NameOfTheMaterial, const FString & PathToPutMaterial)
@@ -162,265 +386,495 @@ UMaterial * UQuickMaterialCreationWidget::CreateMaterialAsset(const FString & Na
 }
 
 void UQuickMaterialCreationWidget::Default_CreateMaterialNodes(UMaterial* CreatedMaterial, 
-UTexture2D * SelectedTexture, uint32 & PinsConnectedCounter)
+UTexture2D * SelectedTexture, ETextureRole TextureRole, uint32 & PinsConnectedCounter)
 {
 	UMaterialExpressionTextureSample* TextureSampleNode =
 	NewObject<UMaterialExpressionTextureSample>(CreatedMaterial);
 
 	if(!TextureSampleNode) return;
 
-	if(!CreatedMaterial->BaseColor.IsConnected())
+	bool bPinConnected = false;
+
+	switch(TextureRole)
 	{
+	case ETextureRole::ETR_BaseColor:
+
+		bPinConnected = TryConnectBaseColor(TextureSampleNode,SelectedTexture,CreatedMaterial);
+		break;
+
+	case ETextureRole::ETR_Metallic:
+
+		bPinConnected = TryConnectMetalic(TextureSampleNode,SelectedTexture,CreatedMaterial);
+		break;
+
+	case ETextureRole::ETR_Roughness:
+
+		bPinConnected = TryConnectRoughness(TextureSampleNode,SelectedTexture,CreatedMaterial);
+		break;
+
+	case ETextureRole::ETR_Normal:
+
+		bPinConnected = TryConnectNormal(TextureSampleNode,SelectedTexture,CreatedMaterial);
+		break;
+
+	case ETextureRole::ETR_AmbientOcclusion:
+
+		bPinConnected = TryConnectAO(TextureSampleNode,SelectedTexture,CreatedMaterial);
+		break;
+
+	default:
+		break;
+	}
+
+	if(bPinConnected)
+	{
+		PinsConnectedCounter++;
+		return;
+	}
+
+	DebugHeader::Print(TEXT("Failed to connect the texture: ") + SelectedTexture->GetName(),FColor::Red);
+}
+
+void UQuickMaterialCreationWidget::ORM_CreateMaterialNodes(UMaterial* CreatedMaterial, 
+UTexture2D * SelectedTexture, ETextureRole TextureRole, uint32 & PinsConnectedCounter)
+{
+	UMaterialExpressionTextureSample* TextureSampleNode =
+	NewObject<UMaterialExpressionTextureSample>(CreatedMaterial);
+
+	if(!TextureSampleNode) return;
+
+	switch(TextureRole)
+	{
+	case ETextureRole::ETR_BaseColor:
+
 		if(TryConnectBaseColor(TextureSampleNode,SelectedTexture,CreatedMaterial))
 		{
 			PinsConnectedCounter++;
-			return;
 		}
-	}
+		break;
 
-	if(!CreatedMaterial->Metallic.IsConnected())
-	{
-		if(TryConnectMetalic(TextureSampleNode, SelectedTexture, CreatedMaterial))
+	case ETextureRole::ETR_Normal:
+
+		if(TryConnectNormal(TextureSampleNode,SelectedTexture,CreatedMaterial))
 		{
 			PinsConnectedCounter++;
-			return;
 		}
+		break;
+
+	case ETextureRole::ETR_ORM:
+
+		if(TryConnectORM(TextureSampleNode,SelectedTexture,CreatedMaterial))
+		{
+			PinsConnectedCounter+=3;
+		}
+		break;
+
+	default:
+		break;
 	}
+}
+
+#pragma endregion
 
-	if(!CreatedMaterial->Roughness.IsConnected())
+#pragma region BatchMaterialCreation
+
+void UQuickMaterialCreationWidget::CreateMaterialsFromTextureSets()
+{
+	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
+
+	if(SelectedAssetsData.Num()==0)
 	{
-		if(TryConnectRoughness(TextureSampleNode, SelectedTexture, CreatedMaterial))
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok,TEXT("No texture selected"));
+		return;
+	}
+
+	//Gather candidates from registry data, nothing is loaded before it is known to belong to a set
+	TArray<FAssetData> TexturesData;
+
+	if(bIncludeWholeFolder)
+	{
+		FARFilter Filter;
+		Filter.ClassNames.Emplace(UTexture2D::StaticClass()->GetFName());
+
+		for(const FAssetData& SelectedAssetData:SelectedAssetsData)
 		{
-			PinsConnectedCounter++;
-			return;
+			Filter.PackagePaths.AddUnique(SelectedAssetData.PackagePath);
+		}
+
+		IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+		AssetRegistry.GetAssets(Filter,TexturesData);
+	}
+	else
+	{
+		for(const FAssetData& SelectedAssetData:SelectedAssetsData)
+		{
+			if(SelectedAssetData.AssetClass == UTexture2D::StaticClass()->GetFName())
+			{
+				TexturesData.Add(SelectedAssetData);
+			}
 		}
 	}
 
-	if(!CreatedMaterial->Normal.IsConnected())
+	//Classification is pure string work, so it runs in parallel
+	const FTextureRoleClassifier TextureRoleClassifier = CompileTextureRoleClassifier();
+
+	TArray<FTextureRoleMatch> TextureRoleMatches;
+	TextureRoleMatches.SetNum(TexturesData.Num());
+
+	ParallelFor(TexturesData.Num(),[&](int32 TextureIndex)
+	{
+		TextureRoleClassifier.Classify(TexturesData[TextureIndex].AssetName.ToString(),TextureRoleMatches[TextureIndex]);
+	});
+
+	//Group by folder and the texture name without its role pattern
+	struct FTextureSet
+	{
+		FString PackagePath;
+		FString BaseName;
+		TArray< TPair <FAssetData, ETextureRole> > Textures;
+	};
+
+	TMap<FString, FTextureSet> TextureSets;
+
+	for(int32 TextureIndex = 0; TextureIndex<TexturesData.Num(); TextureIndex++)
+	{
+		const FTextureRoleMatch& TextureRoleMatch = TextureRoleMatches[TextureIndex];
+
+		if(TextureRoleMatch.Role == ETextureRole::ETR_None) continue;
+
+		const FAssetData& TextureData = TexturesData[TextureIndex];
+
+		FString BaseName = TextureData.AssetName.ToString();
+		BaseName.RemoveAt(TextureRoleMatch.MatchStart,TextureRoleMatch.MatchLength);
+
+		const FString SetKey = TextureData.PackagePath.ToString() / (bIgnoreCaseInTextureNames ? BaseName.ToLower() : BaseName);
+
+		FTextureSet& TextureSet = TextureSets.FindOrAdd(SetKey);
+		TextureSet.PackagePath = TextureData.PackagePath.ToString();
+		TextureSet.BaseName = BaseName;
+		TextureSet.Textures.Emplace(TextureData,TextureRoleMatch.Role);
+	}
+
+	if(TextureSets.Num()==0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok,TEXT("No texture matches a supported texture name"));
+		return;
+	}
+
+	UMaterialInterface* LoadedMasterMaterial = nullptr;
+
+	if(bUseMasterMaterial)
+	{
+		LoadedMasterMaterial = LoadMasterMaterial();
+
+		if(!LoadedMasterMaterial) return;
+	}
+
+	FAssetNameAllocator NameAllocator;
+	TArray<UPackage*> PackagesToSave;
+	TArray<UMaterial*> CreatedMaterials;
+	TArray<FString> CreatedMaterialNames;
+	uint32 InstancesCreatedCounter = 0;
+
+	FScopedSlowTask CreationTask(TextureSets.Num(),FText::FromString(TEXT("Creating materials")));
+	CreationTask.MakeDialog(true);
+
+	for(const TPair<FString,FTextureSet>& TextureSetPair:TextureSets)
 	{
-		if(TryConnectNormal(TextureSampleNode, SelectedTexture, CreatedMaterial))
+		if(CreationTask.ShouldCancel()) break;
+
+		CreationTask.EnterProgressFrame();
+
+		const FTextureSet& TextureSet = TextureSetPair.Value;
+
+		FString SetMaterialName = TextureSet.BaseName;
+		SetMaterialName.RemoveFromStart(TEXT("T_"));
+		SetMaterialName.InsertAt(0,TEXT("M_"));
+
+		FString UsedName;
+
+		if(!ReserveMaterialNames(NameAllocator,TextureSet.PackagePath,SetMaterialName,UsedName))
 		{
-			PinsConnectedCounter++;
-			return;
+			DebugHeader::PrintLog(UsedName + TEXT(" is already used by asset, skipped"));
+			continue;
+		}
+
+		TArray< TPair <UTexture2D*, ETextureRole> > ClassifiedTextures;
+
+		for(const TPair<FAssetData,ETextureRole>& SetTexture:TextureSet.Textures)
+		{
+			if(UTexture2D* LoadedTexture = Cast<UTexture2D>(SetTexture.Key.GetAsset()))
+			{
+				ClassifiedTextures.Emplace(LoadedTexture,SetTexture.Value);
+			}
+		}
+
+		if(ChannelPackingType == E_ChannelPackingType::ECPT_ORM)
+		{
+			if(UTexture2D* PackedTexture = 
+			PackSeparateMasksIntoORM(ClassifiedTextures,TextureSet.PackagePath,TextureSet.BaseName + TEXT("_ORM"),NameAllocator))
+			{
+				PackagesToSave.Add(PackedTexture->GetOutermost());
+			}
+		}
+
+		if(LoadedMasterMaterial)
+		{
+			if(UMaterialInstanceConstant* CreatedMI = 
+			CreateMaterialInstanceAsset(LoadedMasterMaterial,SetMaterialName,TextureSet.PackagePath,ClassifiedTextures))
+			{
+				PackagesToSave.Add(CreatedMI->GetOutermost());
+				++InstancesCreatedCounter;
+			}
+
+			continue;
 		}
+
+		UMaterial* CreatedMaterial = CreateMaterialAsset(SetMaterialName,TextureSet.PackagePath);
+
+		if(!CreatedMaterial) continue;
+
+		uint32 PinsConnectedCounter = 0;
+		CreateMaterialNodesForTextures(CreatedMaterial,ClassifiedTextures,ChannelPackingType,PinsConnectedCounter);
+
+		CreatedMaterials.Add(CreatedMaterial);
+		CreatedMaterialNames.Add(SetMaterialName);
+		PackagesToSave.Add(CreatedMaterial->GetOutermost());
 	}
 
-	if(!CreatedMaterial->AmbientOcclusion.IsConnected())
+	//Every graph is wired, texture rebuilds and shader compiles of the whole batch run together
+	TextureSettingsBatch.Apply();
+
+	RecompileMaterials(CreatedMaterials);
+
+	//Instances are made once their parents are compiled
+	if(bCreateMaterialInstance)
 	{
-		if(TryConnectAO(TextureSampleNode, SelectedTexture, CreatedMaterial))
+		for(int32 MaterialIndex = 0; MaterialIndex<CreatedMaterials.Num(); MaterialIndex++)
 		{
-			PinsConnectedCounter++;
-			return;
+			UMaterial* CreatedMaterial = CreatedMaterials[MaterialIndex];
+
+			const FString MaterialFolderPath = FPackageName::GetLongPackagePath(CreatedMaterial->GetOutermost()->GetName());
+
+			if(UMaterialInstanceConstant* CreatedMI = 
+			CreateMaterialInstanceAsset(CreatedMaterial,CreatedMaterialNames[MaterialIndex],MaterialFolderPath))
+			{
+				PackagesToSave.Add(CreatedMI->GetOutermost());
+			}
 		}
 	}
 
-	DebugHeader::Print(TEXT("Failed to connect the texture: ") + SelectedTexture->GetName(),FColor::Red);
+	//Single save pass for every created material and instance
+	if(PackagesToSave.Num()>0)
+	{
+		UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave,false);
+	}
+
+	if(InstancesCreatedCounter>0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("Successfully created ") 
+		+ FString::FromInt(InstancesCreatedCounter) + TEXT(" material instances"));
+	}
+
+	if(CreatedMaterials.Num()>0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("Successfully created ") 
+		+ FString::FromInt(CreatedMaterials.Num()) + TEXT(" materials"));
+	}
 }
 
-void UQuickMaterialCreationWidget::ORM_CreateMaterialNodes(UMaterial* CreatedMaterial, 
-UTexture2D * SelectedTexture, uint32 & PinsConnectedCounter)
+#pragma endregion
+
+#pragma region TextureSettingsFixUp
+
+void UQuickMaterialCreationWidget::FixTextureSettingsInSelectedFolders()
 {
-	UMaterialExpressionTextureSample* TextureSampleNode =
-	NewObject<UMaterialExpressionTextureSample>(CreatedMaterial);
+	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
 
-	if(!TextureSampleNode) return;
+	if(SelectedAssetsData.Num()==0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok,TEXT("No asset selected"));
+		return;
+	}
 
-	if(!CreatedMaterial->BaseColor.IsConnected())
+	FARFilter Filter;
+	Filter.ClassNames.Emplace(UTexture2D::StaticClass()->GetFName());
+
+	for(const FAssetData& SelectedAssetData:SelectedAssetsData)
 	{
-		if(TryConnectBaseColor(TextureSampleNode,SelectedTexture,CreatedMaterial))
-		{
-			PinsConnectedCounter++;
-			return;
-		}
+		Filter.PackagePaths.AddUnique(SelectedAssetData.PackagePath);
 	}
 
-	if(!CreatedMaterial->Normal.IsConnected())
+	TArray<FAssetData> TexturesData;
+
+	IAssetRegistry& AssetRegistry =
+	FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.GetAssets(Filter,TexturesData);
+
+	//Roles come from the names and current settings from the registry tags, nothing is loaded yet
+	const FTextureRoleClassifier TextureRoleClassifier = CompileTextureRoleClassifier();
+
+	TArray<ETextureRole> TextureRolesToFix;
+	TextureRolesToFix.Init(ETextureRole::ETR_None,TexturesData.Num());
+
+	ParallelFor(TexturesData.Num(),[&](int32 TextureIndex)
+	{
+		FTextureRoleMatch TextureRoleMatch;
+
+		if(!TextureRoleClassifier.Classify(TexturesData[TextureIndex].AssetName.ToString(),TextureRoleMatch)) return;
+
+		const FTextureSettingsChange Change = FTextureSettingsChange::ForRole(TextureRoleMatch.Role);
+
+		if(Change.IsEmpty() || Change.IsSatisfiedBy(TexturesData[TextureIndex])) return;
+
+		TextureRolesToFix[TextureIndex] = TextureRoleMatch.Role;
+	});
+
+	//Only the textures with wrong settings get loaded
+	for(int32 TextureIndex = 0; TextureIndex<TexturesData.Num(); TextureIndex++)
 	{
-		if(TryConnectNormal(TextureSampleNode, SelectedTexture, CreatedMaterial))
+		if(TextureRolesToFix[TextureIndex] == ETextureRole::ETR_None) continue;
+
+		if(UTexture* LoadedTexture = Cast<UTexture>(TexturesData[TextureIndex].GetAsset()))
 		{
-			PinsConnectedCounter++;
-			return;
+			TextureSettingsBatch.QueueChangeForRole(LoadedTexture,TextureRolesToFix[TextureIndex]);
 		}
 	}
 
-	if(!CreatedMaterial->Roughness.IsConnected())
+	const int32 NumOfFixedTextures = TextureSettingsBatch.Apply();
+
+	if(NumOfFixedTextures==0)
 	{
-		if(TryConnectORM(TextureSampleNode, SelectedTexture, CreatedMaterial))
-		{
-			PinsConnectedCounter+=3;
-			return;
-		}
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok,TEXT("All mask and normal textures already have the right settings"));
+		return;
 	}
+
+	DebugHeader::ShowNotifyInfo(TEXT("Fixed settings of ") + FString::FromInt(NumOfFixedTextures) + TEXT(" textures"));
 }
 
 #pragma endregion
 
 #pragma region CreateMaterialNodesConnectPins
 
+//Texture roles are already classified by name, these only wire the node if the pin is still free.
+//Texture settings are queued and applied for all textures together once the graph is wired
+
 bool UQuickMaterialCreationWidget::TryConnectBaseColor(UMaterialExpressionTextureSample * TextureSampleNode, 
 UTexture2D * SelectedTexture, UMaterial * CreatedMaterial)
 {
-	for(const FString& BaseColorName:BaseColorArray)
-	{
-		if(SelectedTexture->GetName().Contains(BaseColorName))
-		{
-			//Connect pins to base color socket here
-			TextureSampleNode->Texture = SelectedTexture;
+	if(CreatedMaterial->BaseColor.IsConnected()) return false;
 
-			CreatedMaterial->Expressions.Add(TextureSampleNode);
-			CreatedMaterial->BaseColor.Expression = TextureSampleNode;
-			CreatedMaterial->PostEditChange();
-			 
-			TextureSampleNode->MaterialExpressionEditorX -=600;
+	//Connect pins to base color socket here
+	TextureSampleNode->Texture = SelectedTexture;
 
-			return true;
-		}
-	}
+	CreatedMaterial->Expressions.Add(TextureSampleNode);
+	CreatedMaterial->BaseColor.Expression = TextureSampleNode;
+	 
+	TextureSampleNode->MaterialExpressionEditorX -=600;
 
-	return false;
+	return true;
 }
 
 bool UQuickMaterialCreationWidget::TryConnectMetalic(UMaterialExpressionTextureSample * TextureSampleNode, 
 UTexture2D * SelectedTexture, UMaterial * CreatedMaterial)
 {
-	for(const FString& MetalicName:MetallicArray)
-	{
-		if(SelectedTexture->GetName().Contains(MetalicName))
-		{
-			SelectedTexture->CompressionSettings = TextureCompressionSettings::TC_Default;
-			SelectedTexture->SRGB = false;
-			SelectedTexture->PostEditChange();
+	if(CreatedMaterial->Metallic.IsConnected()) return false;
 
-			TextureSampleNode->Texture = SelectedTexture;
-			TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
+	TextureSettingsBatch.QueueChangeForRole(SelectedTexture,ETextureRole::ETR_Metallic);
 
-			CreatedMaterial->Expressions.Add(TextureSampleNode);
-			CreatedMaterial->Metallic.Expression = TextureSampleNode;
-			CreatedMaterial->PostEditChange();
+	TextureSampleNode->Texture = SelectedTexture;
+	TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
 
-			TextureSampleNode->MaterialExpressionEditorX -=600;
-			TextureSampleNode->MaterialExpressionEditorY +=240;
+	CreatedMaterial->Expressions.Add(TextureSampleNode);
+	CreatedMaterial->Metallic.Expression = TextureSampleNode;
 
-			return true;
-		}
-	}
-	
-	return false;
+	TextureSampleNode->MaterialExpressionEditorX -=600;
+	TextureSampleNode->MaterialExpressionEditorY +=240;
+
+	return true;
 }
 
 bool UQuickMaterialCreationWidget::TryConnectRoughness(UMaterialExpressionTextureSample * TextureSampleNode, UTexture2D * SelectedTexture, UMaterial * CreatedMaterial)
 {
-	for(const FString& RoughnessName:RoughnessArray)
-	{
-		if(SelectedTexture->GetName().Contains(RoughnessName))
-		{
-			SelectedTexture->CompressionSettings = TextureCompressionSettings::TC_Default;
-			SelectedTexture->SRGB = false;
-			SelectedTexture->PostEditChange();
+	if(CreatedMaterial->Roughness.IsConnected()) return false;
 
-			TextureSampleNode->Texture = SelectedTexture;
-			TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
+	TextureSettingsBatch.QueueChangeForRole(SelectedTexture,ETextureRole::ETR_Roughness);
 
-			CreatedMaterial->Expressions.Add(TextureSampleNode);
-			CreatedMaterial->Roughness.Expression = TextureSampleNode;
-			CreatedMaterial->PostEditChange();
+	TextureSampleNode->Texture = SelectedTexture;
+	TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
 
-			TextureSampleNode->MaterialExpressionEditorX -=600;
-			TextureSampleNode->MaterialExpressionEditorY +=480;
+	CreatedMaterial->Expressions.Add(TextureSampleNode);
+	CreatedMaterial->Roughness.Expression = TextureSampleNode;
 
-			return true;
-		}
-	}
+	TextureSampleNode->MaterialExpressionEditorX -=600;
+	TextureSampleNode->MaterialExpressionEditorY +=480;
 
-	return false;
+	return true;
 }
 
 bool UQuickMaterialCreationWidget::TryConnectNormal(UMaterialExpressionTextureSample * TextureSampleNode, UTexture2D * SelectedTexture, UMaterial * CreatedMaterial)
 {
-	for(const FString& NormalName:NormalArray)
-	{	
-		if(SelectedTexture->GetName().Contains(NormalName))
-		{
-			TextureSampleNode->Texture = SelectedTexture;
-			TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_Normal;
+	if(CreatedMaterial->Normal.IsConnected()) return false;
 
-			CreatedMaterial->Expressions.Add(TextureSampleNode);
-			CreatedMaterial->Normal.Expression = TextureSampleNode;
-			CreatedMaterial->PostEditChange();
+	TextureSettingsBatch.QueueChangeForRole(SelectedTexture,ETextureRole::ETR_Normal);
 
-			TextureSampleNode->MaterialExpressionEditorX -= 600;
-			TextureSampleNode->MaterialExpressionEditorY += 720;
+	TextureSampleNode->Texture = SelectedTexture;
+	TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_Normal;
 
-			return true;
-		}
-	}
-	
-	return false;
+	CreatedMaterial->Expressions.Add(TextureSampleNode);
+	CreatedMaterial->Normal.Expression = TextureSampleNode;
+
+	TextureSampleNode->MaterialExpressionEditorX -= 600;
+	TextureSampleNode->MaterialExpressionEditorY += 720;
+
+	return true;
 }
 
 bool UQuickMaterialCreationWidget::TryConnectAO(UMaterialExpressionTextureSample * TextureSampleNode, UTexture2D * SelectedTexture, UMaterial * CreatedMaterial)
 {
-	for(const FString& AOName:AmbientOcclusionArray)
-	{	
-		if(SelectedTexture->GetName().Contains(AOName))
-		{
-			SelectedTexture->CompressionSettings = TextureCompressionSettings::TC_Default;
-			SelectedTexture->SRGB = false;
-			SelectedTexture->PostEditChange();
-
-			TextureSampleNode->Texture = SelectedTexture;
-			TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
+	if(CreatedMaterial->AmbientOcclusion.IsConnected()) return false;
 
-			CreatedMaterial->Expressions.Add(TextureSampleNode);
-			CreatedMaterial->AmbientOcclusion.Expression = TextureSampleNode;
-			CreatedMaterial->PostEditChange();
+	TextureSettingsBatch.QueueChangeForRole(SelectedTexture,ETextureRole::ETR_AmbientOcclusion);
 
+	TextureSampleNode->Texture = SelectedTexture;
+	TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
 
-			TextureSampleNode->MaterialExpressionEditorX -= 600;
-			TextureSampleNode->MaterialExpressionEditorY += 960;
+	CreatedMaterial->Expressions.Add(TextureSampleNode);
+	CreatedMaterial->AmbientOcclusion.Expression = TextureSampleNode;
 
-			return true;
-		}
-	}
+	TextureSampleNode->MaterialExpressionEditorX -= 600;
+	TextureSampleNode->MaterialExpressionEditorY += 960;
 
-	return false;
+	return true;
 }
 
 bool UQuickMaterialCreationWidget::TryConnectORM(UMaterialExpressionTextureSample * TextureSampleNode, UTexture2D * SelectedTexture, UMaterial * CreatedMaterial)
 {	
-	for(const FString& ORM_Name:ORMArray)
-	{
-		if(SelectedTexture->GetName().Contains(ORM_Name))
-		{
-			SelectedTexture->CompressionSettings = TextureCompressionSettings::TC_Masks;
-			SelectedTexture->SRGB = false;
-			SelectedTexture->PostEditChange();
+	if(CreatedMaterial->Roughness.IsConnected()) return false;
 
-			TextureSampleNode->Texture = SelectedTexture;
-			TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_Masks;
+	TextureSettingsBatch.QueueChangeForRole(SelectedTexture,ETextureRole::ETR_ORM);
 
-			CreatedMaterial->Expressions.Add(TextureSampleNode);
-			CreatedMaterial->AmbientOcclusion.Connect(1,TextureSampleNode);
-			CreatedMaterial->Roughness.Connect(2,TextureSampleNode);
-			CreatedMaterial->Metallic.Connect(3,TextureSampleNode);
-			CreatedMaterial->PostEditChange();
+	TextureSampleNode->Texture = SelectedTexture;
+	TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_Masks;
 
-			TextureSampleNode->MaterialExpressionEditorX -= 600;
-			TextureSampleNode->MaterialExpressionEditorY += 960;
+	CreatedMaterial->Expressions.Add(TextureSampleNode);
+	CreatedMaterial->AmbientOcclusion.Connect(1,TextureSampleNode);
+	CreatedMaterial->Roughness.Connect(2,TextureSampleNode);
+	CreatedMaterial->Metallic.Connect(3,TextureSampleNode);
 
-			return true;
-		}
-	}
-	return false;
+	TextureSampleNode->MaterialExpressionEditorX -= 600;
+	TextureSampleNode->MaterialExpressionEditorY += 960;
+
+	return true;
 }
 
 #pragma endregion
 
-UMaterialInstanceConstant* UQuickMaterialCreationWidget::CreateMaterialInstanceAsset(UMaterial * CreatedMaterial, 
-FString NameOfMaterialInstance, const FString & PathToPutMI)
+UMaterialInstanceConstant* UQuickMaterialCreationWidget::CreateMaterialInstanceAsset(UMaterialInterface * ParentMaterial, 
+FString NameOfMaterialInstance, const FString & PathToPutMI, const TArray<TPair<UTexture2D*, ETextureRole>>& TextureParameters)
 {	
-	NameOfMaterialInstance.RemoveFromStart(TEXT("M_"));
-	NameOfMaterialInstance.InsertAt(0,TEXT("MI_"));
+	NameOfMaterialInstance = MakeMaterialInstanceName(NameOfMaterialInstance);
 
 	UMaterialInstanceConstantFactoryNew* MIFactoryNew = NewObject<UMaterialInstanceConstantFactoryNew>();
 
@@ -431,13 +885,61 @@ FString NameOfMaterialInstance, const FString & PathToPutMI)
 
 	if(UMaterialInstanceConstant* CreatedMI = Cast<UMaterialInstanceConstant>(CreatedObject))
 	{
-		CreatedMI->SetParentEditorOnly(CreatedMaterial);
+		CreatedMI->SetParentEditorOnly(ParentMaterial);
 
-		CreatedMI->PostEditChange();
-		CreatedMaterial->PostEditChange();
+		for(const TPair<UTexture2D*,ETextureRole>& TextureParameter:TextureParameters)
+		{
+			const FName ParameterName = GetTextureParameterNameForRole(TextureParameter.Value);
 
+			if(ParameterName.IsNone()) continue;
+
+			CreatedMI->SetTextureParameterValueEditorOnly(FMaterialParameterInfo(ParameterName),TextureParameter.Key);
+			TextureSettingsBatch.QueueChangeForRole(TextureParameter.Key,TextureParameter.Value);
+		}
+
+		CreatedMI->PostEditChange();
+	
 		return CreatedMI;
 	}
 
 	return nullptr;
 }
+
+FName UQuickMaterialCreationWidget::GetTextureParameterNameForRole(ETextureRole TextureRole) const
+{
+	switch(TextureRole)
+	{
+	case ETextureRole::ETR_BaseColor:
+		return BaseColorParameterName;
+
+	case ETextureRole::ETR_Metallic:
+		return MetallicParameterName;
+
+	case ETextureRole::ETR_Roughness:
+		return RoughnessParameterName;
+
+	case ETextureRole::ETR_Normal:
+		return NormalParameterName;
+
+	case ETextureRole::ETR_AmbientOcclusion:
+		return AmbientOcclusionParameterName;
+
+	case ETextureRole::ETR_ORM:
+		return ORMParameterName;
+
+	default:
+		return NAME_None;
+	}
+}
+
+UMaterialInterface* UQuickMaterialCreationWidget::LoadMasterMaterial()
+{
+	UMaterialInterface* LoadedMasterMaterial = MasterMaterial.LoadSynchronous();
+
+	if(!LoadedMasterMaterial)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok,TEXT("Please pick a master material"));
+	}
+
+	return LoadedMasterMaterial;
+}
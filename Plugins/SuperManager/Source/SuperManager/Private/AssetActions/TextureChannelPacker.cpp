@@ -0,0 +1,156 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetActions/TextureChannelPacker.h"
+#include "Engine/Texture2D.h"
+#include "ImageCore.h"
+#include "Async/ParallelFor.h"
+#include "AssetRegistryModule.h"
+
+//Values used for a channel without input texture, full occlusion, mid roughness, not metallic
+static constexpr uint8 DefaultAOValue = 255;
+static constexpr uint8 DefaultRoughnessValue = 128;
+static constexpr uint8 DefaultMetallicValue = 0;
+
+UTexture2D* FTextureChannelPacker::PackORM(UTexture2D* AOTexture, UTexture2D* RoughnessTexture, 
+UTexture2D* MetallicTexture, const FString& PackagePath, const FString& TextureName, FString& OutErrorMessage)
+{
+	if(!AOTexture && !RoughnessTexture && !MetallicTexture)
+	{
+		OutErrorMessage = TEXT("No texture to pack");
+		return nullptr;
+	}
+
+	FChannelSource ChannelSources[3];
+
+	if(!ReadChannelSource(AOTexture,DefaultAOValue,ChannelSources[0],OutErrorMessage) ||
+	!ReadChannelSource(RoughnessTexture,DefaultRoughnessValue,ChannelSources[1],OutErrorMessage) ||
+	!ReadChannelSource(MetallicTexture,DefaultMetallicValue,ChannelSources[2],OutErrorMessage))
+	{
+		return nullptr;
+	}
+
+	//Packed texture gets the resolution of the largest input
+	int32 PackedSizeX = 0;
+	int32 PackedSizeY = 0;
+
+	for(const FChannelSource& ChannelSource:ChannelSources)
+	{
+		PackedSizeX = FMath::Max(PackedSizeX,ChannelSource.SizeX);
+		PackedSizeY = FMath::Max(PackedSizeY,ChannelSource.SizeY);
+	}
+
+	TArray64<uint8> PackedPixels;
+	PackedPixels.SetNumUninitialized(static_cast<int64>(PackedSizeX)*PackedSizeY*4);
+
+	const int32 NumOfTasks = FMath::DivideAndRoundUp(PackedSizeY,PackRowsPerTask);
+
+	ParallelFor(NumOfTasks,[&](int32 TaskIndex)
+	{
+		const int32 RowStart = TaskIndex*PackRowsPerTask;
+		const int32 RowEnd = FMath::Min(RowStart+PackRowsPerTask,PackedSizeY);
+
+		for(int32 Y = RowStart; Y<RowEnd; Y++)
+		{
+			uint8* PackedRow = PackedPixels.GetData() + static_cast<int64>(Y)*PackedSizeX*4;
+
+			//BGRA8 layout, AO goes to R, roughness to G and metallic to B
+			for(int32 X = 0; X<PackedSizeX; X++)
+			{
+				PackedRow[X*4+0] = ChannelSources[2].Sample(X,Y,PackedSizeX,PackedSizeY);
+				PackedRow[X*4+1] = ChannelSources[1].Sample(X,Y,PackedSizeX,PackedSizeY);
+				PackedRow[X*4+2] = ChannelSources[0].Sample(X,Y,PackedSizeX,PackedSizeY);
+				PackedRow[X*4+3] = 255;
+			}
+		}
+	});
+
+	const FString PackageName = PackagePath / TextureName;
+	UPackage* Package = CreatePackage(*PackageName);
+
+	UTexture2D* PackedTexture = NewObject<UTexture2D>(Package,*TextureName,RF_Public|RF_Standalone|RF_Transactional);
+
+	PackedTexture->Source.Init(PackedSizeX,PackedSizeY,1,1,TSF_BGRA8,PackedPixels.GetData());
+	PackedTexture->CompressionSettings = TextureCompressionSettings::TC_Masks;
+	PackedTexture->SRGB = false;
+	PackedTexture->PostEditChange();
+
+	FAssetRegistryModule::AssetCreated(PackedTexture);
+	Package->MarkPackageDirty();
+
+	return PackedTexture;
+}
+
+bool FTextureChannelPacker::ReadChannelSource(UTexture2D* Texture, uint8 DefaultValue, 
+FChannelSource& OutSource, FString& OutErrorMessage)
+{
+	OutSource.DefaultValue = DefaultValue;
+
+	if(!Texture) return true;
+
+	ERawImageFormat::Type RawImageFormat;
+
+	switch(Texture->Source.GetFormat())
+	{
+	case TSF_G8:		RawImageFormat = ERawImageFormat::G8;		break;
+	case TSF_G16:		RawImageFormat = ERawImageFormat::G16;		break;
+	case TSF_BGRA8:		RawImageFormat = ERawImageFormat::BGRA8;	break;
+	case TSF_BGRE8:		RawImageFormat = ERawImageFormat::BGRE8;	break;
+	case TSF_RGBA16:	RawImageFormat = ERawImageFormat::RGBA16;	break;
+	case TSF_RGBA16F:	RawImageFormat = ERawImageFormat::RGBA16F;	break;
+
+	default:
+		OutErrorMessage = Texture->GetName() + TEXT(" has an unsupported source format");
+		return false;
+	}
+
+	//Mask values are data, read them as stored even if the texture is flagged sRGB
+	FImage SourceImage(Texture->Source.GetSizeX(),Texture->Source.GetSizeY(),RawImageFormat,EGammaSpace::Linear);
+
+	if(!Texture->Source.GetMipData(SourceImage.RawData,0,0,0))
+	{
+		OutErrorMessage = TEXT("Failed to read the source of ") + Texture->GetName();
+		return false;
+	}
+
+	FImage BGRAImage;
+	SourceImage.CopyTo(BGRAImage,ERawImageFormat::BGRA8,EGammaSpace::Linear);
+
+	OutSource.Pixels = MoveTemp(BGRAImage.RawData);
+	OutSource.SizeX = BGRAImage.SizeX;
+	OutSource.SizeY = BGRAImage.SizeY;
+
+	return true;
+}
+
+uint8 FTextureChannelPacker::FChannelSource::Sample(int32 X, int32 Y, int32 DestSizeX, int32 DestSizeY) const
+{
+	if(Pixels.Num()==0) return DefaultValue;
+
+	//Same resolution, R of the matching pixel
+	if(SizeX==DestSizeX && SizeY==DestSizeY)
+	{
+		return Pixels[(static_cast<int64>(Y)*SizeX+X)*4+2];
+	}
+
+	//Bilinear resample at the pixel center
+	const float SourceX = FMath::Max((X+0.5f)*SizeX/DestSizeX-0.5f,0.f);
+	const float SourceY = FMath::Max((Y+0.5f)*SizeY/DestSizeY-0.5f,0.f);
+
+	const int32 X0 = FMath::Min(FMath::FloorToInt(SourceX),SizeX-1);
+	const int32 Y0 = FMath::Min(FMath::FloorToInt(SourceY),SizeY-1);
+	const int32 X1 = FMath::Min(X0+1,SizeX-1);
+	const int32 Y1 = FMath::Min(Y0+1,SizeY-1);
+
+	const float AlphaX = SourceX-X0;
+	const float AlphaY = SourceY-Y0;
+
+	auto ReadRed = [this](int32 ReadX, int32 ReadY)
+	{
+		return static_cast<float>(Pixels[(static_cast<int64>(ReadY)*SizeX+ReadX)*4+2]);
+	};
+
+	const float Top = FMath::Lerp(ReadRed(X0,Y0),ReadRed(X1,Y0),AlphaX);
+	const float Bottom = FMath::Lerp(ReadRed(X0,Y1),ReadRed(X1,Y1),AlphaX);
+
+	return static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(FMath::Lerp(Top,Bottom,AlphaY)),0,255));
+}
@@ -0,0 +1,218 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetActions/TextureMemoryAudit.h"
+#include "AssetActions/TextureSettingsBatch.h"
+#include "AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "Engine/Texture2D.h"
+#include "Misc/ScopedSlowTask.h"
+#include "SuperManager.h"
+
+void FTextureMemoryAudit::AuditFolders(const TArray<FString>& FolderPathsToAudit, int32 MaxAllowedSize, 
+TArray<FTextureAuditEntry>& OutEntries)
+{
+	OutEntries.Empty();
+
+	IAssetRegistry& AssetRegistry =
+	FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	FARFilter Filter;
+	Filter.bRecursivePaths = true;
+	Filter.bRecursiveClasses = true;
+	Filter.ClassNames.Emplace(UTexture2D::StaticClass()->GetFName());
+
+	for(const FString& FolderPathToAudit:FolderPathsToAudit)
+	{
+		Filter.PackagePaths.Emplace(*FolderPathToAudit);
+	}
+
+	TArray<FAssetData> TexturesData;
+	AssetRegistry.GetAssets(Filter,TexturesData);
+
+	FSuperManagerModule& SuperManagerModule =
+	FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+
+	TArray<FTextureAuditEntry> Entries;
+	Entries.SetNum(TexturesData.Num());
+
+	TArray<bool> EntriesRead;
+	EntriesRead.SetNumZeroed(TexturesData.Num());
+
+	const int32 NumOfChunks = FMath::DivideAndRoundUp(TexturesData.Num(),AuditChunkSize);
+
+	ParallelFor(NumOfChunks,[&](int32 ChunkIndex)
+	{
+		const int32 ChunkStart = ChunkIndex*AuditChunkSize;
+		const int32 ChunkEnd = FMath::Min(ChunkStart+AuditChunkSize,TexturesData.Num());
+
+		for(int32 TextureIndex = ChunkStart; TextureIndex<ChunkEnd; TextureIndex++)
+		{
+			const FAssetData& TextureData = TexturesData[TextureIndex];
+
+			if(!SuperManagerModule.ShouldListAssetPath(TextureData.PackagePath.ToString())) continue;
+
+			FTextureAuditEntry& Entry = Entries[TextureIndex];
+
+			if(!ReadEntryFromTags(TextureData,Entry)) continue;
+
+			Entry.bOversized = Entry.SizeX>MaxAllowedSize || Entry.SizeY>MaxAllowedSize;
+			Entry.bNonPowerOfTwo = !FMath::IsPowerOfTwo(Entry.SizeX) || !FMath::IsPowerOfTwo(Entry.SizeY);
+
+			EntriesRead[TextureIndex] = true;
+		}
+	});
+
+	OutEntries.Reserve(Entries.Num());
+
+	for(int32 TextureIndex = 0; TextureIndex<Entries.Num(); TextureIndex++)
+	{
+		if(EntriesRead[TextureIndex])
+		{
+			OutEntries.Add(MoveTemp(Entries[TextureIndex]));
+		}
+	}
+
+	//Biggest first
+	OutEntries.Sort([](const FTextureAuditEntry& A, const FTextureAuditEntry& B)
+	{
+		return A.EstimatedMemoryInBytes > B.EstimatedMemoryInBytes;
+	});
+}
+
+TMap<FName, int64> FTextureMemoryAudit::SumMemoryPerFolder(const TArray<FTextureAuditEntry>& Entries)
+{
+	TMap<FName, int64> MemoryPerFolder;
+
+	for(const FTextureAuditEntry& Entry:Entries)
+	{
+		MemoryPerFolder.FindOrAdd(Entry.AssetData.PackagePath) += Entry.EstimatedMemoryInBytes;
+	}
+
+	MemoryPerFolder.ValueSort([](int64 A, int64 B)
+	{
+		return A > B;
+	});
+
+	return MemoryPerFolder;
+}
+
+int32 FTextureMemoryAudit::ApplyMaxTextureSize(const TArray<FAssetData>& TexturesData, int32 MaxTextureSize)
+{
+	FTextureSettingsChange Change;
+	Change.MaxTextureSize = MaxTextureSize;
+
+	return ApplySettingsChange(TexturesData,Change);
+}
+
+int32 FTextureMemoryAudit::ApplyLODBias(const TArray<FAssetData>& TexturesData, int32 LODBias)
+{
+	FTextureSettingsChange Change;
+	Change.LODBias = LODBias;
+
+	return ApplySettingsChange(TexturesData,Change);
+}
+
+int32 FTextureMemoryAudit::ApplySettingsChange(const TArray<FAssetData>& TexturesData, const FTextureSettingsChange& Change)
+{
+	FTextureSettingsBatch TextureSettingsBatch;
+
+	FScopedSlowTask LoadingTask(TexturesData.Num(),FText::FromString(TEXT("Loading textures")));
+	LoadingTask.MakeDialog(true);
+
+	for(const FAssetData& TextureData:TexturesData)
+	{
+		if(LoadingTask.ShouldCancel()) break;
+
+		LoadingTask.EnterProgressFrame();
+
+		TextureSettingsBatch.QueueChange(Cast<UTexture>(TextureData.GetAsset()),Change);
+	}
+
+	//Waits for the rebuilt textures, so an audit right after sees their new size and format
+	return TextureSettingsBatch.Apply(true);
+}
+
+FString FTextureMemoryAudit::FormatMemorySize(int64 SizeInBytes)
+{
+	if(SizeInBytes >= 1024*1024*1024) return FString::Printf(TEXT("%.2f GB"),SizeInBytes/(1024.0*1024.0*1024.0));
+	if(SizeInBytes >= 1024*1024) return FString::Printf(TEXT("%.2f MB"),SizeInBytes/(1024.0*1024.0));
+	if(SizeInBytes >= 1024) return FString::Printf(TEXT("%.1f KB"),SizeInBytes/1024.0);
+
+	return FString::Printf(TEXT("%lld B"),SizeInBytes);
+}
+
+bool FTextureMemoryAudit::ReadEntryFromTags(const FAssetData& TextureData, FTextureAuditEntry& OutEntry)
+{
+	//Dimensions tag is "2048x1024", size of the built top mip
+	FString DimensionsValue;
+
+	if(!TextureData.GetTagValue(TEXT("Dimensions"),DimensionsValue)) return false;
+
+	FString SizeXText;
+	FString SizeYText;
+
+	if(!DimensionsValue.Split(TEXT("x"),&SizeXText,&SizeYText)) return false;
+
+	OutEntry.AssetData = TextureData;
+	OutEntry.SizeX = FCString::Atoi(*SizeXText);
+	OutEntry.SizeY = FCString::Atoi(*SizeYText);
+
+	if(OutEntry.SizeX<=0 || OutEntry.SizeY<=0) return false;
+
+	TextureData.GetTagValue(TEXT("Format"),OutEntry.Format);
+
+	FString LODBiasValue;
+
+	if(TextureData.GetTagValue(GET_MEMBER_NAME_CHECKED(UTexture,LODBias),LODBiasValue))
+	{
+		OutEntry.LODBias = FCString::Atoi(*LODBiasValue);
+	}
+
+	//No tag holds the mip count, textures are assumed to have a full mip chain
+	OutEntry.NumOfMips = FMath::FloorLog2(FMath::Max(OutEntry.SizeX,OutEntry.SizeY)) + 1;
+
+	//LOD bias drops the top mips from memory
+	const int32 DroppedMips = FMath::Clamp(OutEntry.LODBias,0,OutEntry.NumOfMips-1);
+
+	OutEntry.EstimatedMemoryInBytes = EstimateMipChainMemory(FMath::Max(OutEntry.SizeX>>DroppedMips,1),
+	FMath::Max(OutEntry.SizeY>>DroppedMips,1),OutEntry.NumOfMips-DroppedMips,OutEntry.Format);
+
+	return true;
+}
+
+int64 FTextureMemoryAudit::EstimateMipChainMemory(int32 SizeX, int32 SizeY, int32 NumOfMips, const FString& Format)
+{
+	//Bits per pixel of the common formats, block compressed formats are stored in 4x4 blocks
+	int32 BitsPerPixel = 32;
+	bool bBlockCompressed = true;
+
+	if(Format.Equals(TEXT("DXT1")) || Format.Equals(TEXT("BC4"))) BitsPerPixel = 4;
+	else if(Format.Equals(TEXT("DXT5")) || Format.Equals(TEXT("BC5")) || Format.Equals(TEXT("BC6H")) || Format.Equals(TEXT("BC7"))) BitsPerPixel = 8;
+	else
+	{
+		bBlockCompressed = false;
+
+		if(Format.Equals(TEXT("G8"))) BitsPerPixel = 8;
+		else if(Format.Equals(TEXT("G16"))) BitsPerPixel = 16;
+		else if(Format.Equals(TEXT("FloatRGBA"))) BitsPerPixel = 64;
+		else if(Format.Equals(TEXT("A32B32G32R32F"))) BitsPerPixel = 128;
+	}
+
+	int64 TotalBits = 0;
+
+	for(int32 MipIndex = 0; MipIndex<NumOfMips; MipIndex++)
+	{
+		int64 MipSizeX = FMath::Max(SizeX>>MipIndex,1);
+		int64 MipSizeY = FMath::Max(SizeY>>MipIndex,1);
+
+		if(bBlockCompressed)
+		{
+			MipSizeX = FMath::Max<int64>(Align(MipSizeX,4),4);
+			MipSizeY = FMath::Max<int64>(Align(MipSizeY,4),4);
+		}
+
+		TotalBits += MipSizeX*MipSizeY*BitsPerPixel;
+	}
+
+	return TotalBits/8;
+}
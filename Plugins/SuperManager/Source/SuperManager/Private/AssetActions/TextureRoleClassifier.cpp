@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetActions/TextureRoleClassifier.h"
+
+void FTextureRoleClassifier::AddPatterns(ETextureRole Role, const TArray<FString>& PatternsToAdd)
+{
+	for(const FString& PatternToAdd:PatternsToAdd)
+	{
+		if(PatternToAdd.IsEmpty()) continue;
+
+		FPattern& Pattern = Patterns.AddDefaulted_GetRef();
+		Pattern.Text = PatternToAdd;
+		Pattern.Role = Role;
+	}
+}
+
+void FTextureRoleClassifier::Compile(bool bInIgnoreCase, bool bInMatchWholeTokens)
+{
+	bIgnoreCase = bInIgnoreCase;
+	bMatchWholeTokens = bInMatchWholeTokens;
+
+	Nodes.Empty();
+	Nodes.AddDefaulted();
+
+	//Build the trie of all patterns
+	for(int32 PatternIndex = 0; PatternIndex<Patterns.Num(); PatternIndex++)
+	{
+		int32 CurrentNode = 0;
+
+		for(const TCHAR PatternChar:Patterns[PatternIndex].Text)
+		{
+			const TCHAR NormalizedChar = NormalizeChar(PatternChar);
+
+			if(const int32* ChildNode = Nodes[CurrentNode].Children.Find(NormalizedChar))
+			{
+				CurrentNode = *ChildNode;
+				continue;
+			}
+
+			const int32 NewNode = Nodes.AddDefaulted();
+			Nodes[CurrentNode].Children.Add(NormalizedChar,NewNode);
+			CurrentNode = NewNode;
+		}
+
+		Nodes[CurrentNode].PatternIndices.Add(PatternIndex);
+	}
+
+	//Breadth first pass to set fail links, every node also inherits the matches of its fail link
+	TArray<int32> NodesToVisit;
+
+	for(const TPair<TCHAR,int32>& RootChild:Nodes[0].Children)
+	{
+		Nodes[RootChild.Value].FailLink = 0;
+		NodesToVisit.Add(RootChild.Value);
+	}
+
+	for(int32 VisitIndex = 0; VisitIndex<NodesToVisit.Num(); VisitIndex++)
+	{
+		const int32 ParentNode = NodesToVisit[VisitIndex];
+
+		for(const TPair<TCHAR,int32>& Child:Nodes[ParentNode].Children)
+		{
+			int32 FailNode = Nodes[ParentNode].FailLink;
+
+			while(FailNode!=0 && !Nodes[FailNode].Children.Contains(Child.Key))
+			{
+				FailNode = Nodes[FailNode].FailLink;
+			}
+
+			const int32* FailTarget = Nodes[FailNode].Children.Find(Child.Key);
+			Nodes[Child.Value].FailLink = (FailTarget && *FailTarget!=Child.Value) ? *FailTarget : 0;
+			Nodes[Child.Value].PatternIndices.Append(Nodes[Nodes[Child.Value].FailLink].PatternIndices);
+
+			NodesToVisit.Add(Child.Value);
+		}
+	}
+}
+
+bool FTextureRoleClassifier::Classify(const FString& TextureName, FTextureRoleMatch& OutMatch) const
+{
+	OutMatch = FTextureRoleMatch();
+
+	if(Nodes.Num()==0) return false;
+
+	int32 CurrentNode = 0;
+
+	for(int32 CharIndex = 0; CharIndex<TextureName.Len(); CharIndex++)
+	{
+		const TCHAR NormalizedChar = NormalizeChar(TextureName[CharIndex]);
+
+		while(CurrentNode!=0 && !Nodes[CurrentNode].Children.Contains(NormalizedChar))
+		{
+			CurrentNode = Nodes[CurrentNode].FailLink;
+		}
+
+		const int32* NextNode = Nodes[CurrentNode].Children.Find(NormalizedChar);
+		CurrentNode = NextNode ? *NextNode : 0;
+
+		for(const int32 PatternIndex:Nodes[CurrentNode].PatternIndices)
+		{
+			const FPattern& Pattern = Patterns[PatternIndex];
+			const int32 MatchLength = Pattern.Text.Len();
+			const int32 MatchStart = CharIndex - MatchLength + 1;
+
+			if(MatchLength <= OutMatch.MatchLength) continue;
+
+			if(bMatchWholeTokens && !IsOnTokenBoundary(TextureName,MatchStart,MatchLength)) continue;
+
+			OutMatch.Role = Pattern.Role;
+			OutMatch.MatchStart = MatchStart;
+			OutMatch.MatchLength = MatchLength;
+		}
+	}
+
+	return OutMatch.Role != ETextureRole::ETR_None;
+}
+
+//A match has to start and end between words, so _AO doesn't match inside _AOrta
+bool FTextureRoleClassifier::IsOnTokenBoundary(const FString& TextureName, int32 MatchStart, int32 MatchLength) const
+{
+	const int32 MatchEnd = MatchStart + MatchLength;
+
+	const bool bStartsOnBoundary = MatchStart==0 ||
+	!FChar::IsAlpha(TextureName[MatchStart]) || !FChar::IsAlpha(TextureName[MatchStart-1]);
+
+	const bool bEndsOnBoundary = MatchEnd==TextureName.Len() ||
+	!FChar::IsAlpha(TextureName[MatchEnd-1]) || !FChar::IsAlpha(TextureName[MatchEnd]);
+
+	return bStartsOnBoundary && bEndsOnBoundary;
+}
@@ -0,0 +1,149 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetActions/TextureSettingsBatch.h"
+#include "Engine/Texture.h"
+#include "TextureCompiler.h"
+#include "Misc/ScopedSlowTask.h"
+
+#pragma region TextureSettingsChange
+
+FTextureSettingsChange FTextureSettingsChange::ForRole(ETextureRole TextureRole)
+{
+	FTextureSettingsChange Change;
+
+	switch(TextureRole)
+	{
+	case ETextureRole::ETR_Metallic:
+	case ETextureRole::ETR_Roughness:
+	case ETextureRole::ETR_AmbientOcclusion:
+
+		Change.CompressionSettings = TextureCompressionSettings::TC_Default;
+		Change.bSRGB = false;
+		break;
+
+	case ETextureRole::ETR_Normal:
+
+		Change.CompressionSettings = TextureCompressionSettings::TC_Normalmap;
+		Change.bSRGB = false;
+		break;
+
+	case ETextureRole::ETR_ORM:
+
+		Change.CompressionSettings = TextureCompressionSettings::TC_Masks;
+		Change.bSRGB = false;
+		break;
+
+	default:
+		break;
+	}
+
+	return Change;
+}
+
+bool FTextureSettingsChange::IsEmpty() const
+{
+	return !CompressionSettings.IsSet() && !bSRGB.IsSet() && !MaxTextureSize.IsSet() && !LODBias.IsSet();
+}
+
+void FTextureSettingsChange::Merge(const FTextureSettingsChange& OtherChange)
+{
+	if(OtherChange.CompressionSettings.IsSet()) CompressionSettings = OtherChange.CompressionSettings;
+	if(OtherChange.bSRGB.IsSet()) bSRGB = OtherChange.bSRGB;
+	if(OtherChange.MaxTextureSize.IsSet()) MaxTextureSize = OtherChange.MaxTextureSize;
+	if(OtherChange.LODBias.IsSet()) LODBias = OtherChange.LODBias;
+}
+
+bool FTextureSettingsChange::IsSatisfiedBy(const UTexture* Texture) const
+{
+	if(CompressionSettings.IsSet() && Texture->CompressionSettings != CompressionSettings.GetValue()) return false;
+	if(bSRGB.IsSet() && static_cast<bool>(Texture->SRGB) != bSRGB.GetValue()) return false;
+	if(MaxTextureSize.IsSet() && Texture->MaxTextureSize != MaxTextureSize.GetValue()) return false;
+	if(LODBias.IsSet() && Texture->LODBias != LODBias.GetValue()) return false;
+
+	return true;
+}
+
+bool FTextureSettingsChange::IsSatisfiedBy(const FAssetData& TextureData) const
+{
+	FString TagValue;
+
+	if(CompressionSettings.IsSet())
+	{
+		if(!TextureData.GetTagValue(GET_MEMBER_NAME_CHECKED(UTexture,CompressionSettings),TagValue)) return false;
+
+		const FString ExpectedValue = 
+		StaticEnum<TextureCompressionSettings>()->GetNameStringByValue(CompressionSettings.GetValue());
+
+		if(!TagValue.Equals(ExpectedValue)) return false;
+	}
+
+	if(bSRGB.IsSet())
+	{
+		if(!TextureData.GetTagValue(GET_MEMBER_NAME_CHECKED(UTexture,SRGB),TagValue)) return false;
+
+		if(FCString::ToBool(*TagValue) != bSRGB.GetValue()) return false;
+	}
+
+	//Not searchable tags, only known once loaded
+	if(MaxTextureSize.IsSet() || LODBias.IsSet()) return false;
+
+	return true;
+}
+
+#pragma endregion
+
+#pragma region TextureSettingsBatch
+
+void FTextureSettingsBatch::QueueChange(UTexture* Texture, const FTextureSettingsChange& Change)
+{
+	if(!Texture || Change.IsEmpty()) return;
+
+	PendingChanges.FindOrAdd(Texture).Merge(Change);
+}
+
+void FTextureSettingsBatch::QueueChangeForRole(UTexture* Texture, ETextureRole TextureRole)
+{
+	QueueChange(Texture,FTextureSettingsChange::ForRole(TextureRole));
+}
+
+int32 FTextureSettingsBatch::Apply(bool bWaitForBuilds)
+{
+	TArray<UTexture*> ChangedTextures;
+
+	FScopedSlowTask ApplyTask(PendingChanges.Num(),FText::FromString(TEXT("Applying texture settings")));
+	ApplyTask.MakeDialogDelayed(1.f);
+
+	for(const TPair<TWeakObjectPtr<UTexture>,FTextureSettingsChange>& PendingChange:PendingChanges)
+	{
+		ApplyTask.EnterProgressFrame();
+
+		UTexture* Texture = PendingChange.Key.Get();
+		const FTextureSettingsChange& Change = PendingChange.Value;
+
+		if(!Texture || Change.IsSatisfiedBy(Texture)) continue;
+
+		Texture->Modify();
+		Texture->PreEditChange(nullptr);
+
+		if(Change.CompressionSettings.IsSet()) Texture->CompressionSettings = Change.CompressionSettings.GetValue();
+		if(Change.bSRGB.IsSet()) Texture->SRGB = Change.bSRGB.GetValue();
+		if(Change.MaxTextureSize.IsSet()) Texture->MaxTextureSize = Change.MaxTextureSize.GetValue();
+		if(Change.LODBias.IsSet()) Texture->LODBias = Change.LODBias.GetValue();
+
+		//With async texture compilation this only queues the rebuild, all of them compile together
+		Texture->PostEditChange();
+
+		ChangedTextures.Add(Texture);
+	}
+
+	PendingChanges.Empty();
+
+	if(bWaitForBuilds && ChangedTextures.Num()>0)
+	{
+		FTextureCompilingManager::Get().FinishCompilation(ChangedTextures);
+	}
+
+	return ChangedTextures.Num();
+}
+
+#pragma endregion
@@ -0,0 +1,409 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetFilter/AssetFilterQuery.h"
+#include "AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "UObject/UObjectIterator.h"
+
+//Number of assets every parallel task evaluates
+static constexpr int32 FilterChunkSize = 256;
+
+bool FAssetFilterQuery::Compile(const FString& QueryString, FString& OutErrorMessage)
+{
+	Predicates.Empty();
+	bNeedsDuplicatedNames = false;
+	bNeedsReferencers = false;
+
+	TArray<FString> Tokens;
+
+	if(!Tokenize(QueryString,Tokens,OutErrorMessage)) return false;
+
+	FString CurrentClause;
+
+	//Group the tokens into clauses separated by AND
+	for(int32 TokenIndex = 0; TokenIndex<=Tokens.Num(); TokenIndex++)
+	{
+		const bool bClauseEnded = TokenIndex==Tokens.Num() || Tokens[TokenIndex].Equals(TEXT("AND"),ESearchCase::IgnoreCase);
+
+		if(!bClauseEnded)
+		{
+			if(!CurrentClause.IsEmpty()) CurrentClause.AppendChar(TEXT(' '));
+			CurrentClause.Append(Tokens[TokenIndex]);
+			continue;
+		}
+
+		if(CurrentClause.IsEmpty())
+		{
+			if(TokenIndex<Tokens.Num())
+			{
+				OutErrorMessage = TEXT("AND is missing a condition");
+				Predicates.Empty();
+				return false;
+			}
+
+			continue;
+		}
+
+		if(!CompileClause(CurrentClause,OutErrorMessage))
+		{
+			Predicates.Empty();
+			return false;
+		}
+
+		CurrentClause.Empty();
+	}
+
+	//Cheap metadata checks first, reference lookups last
+	Predicates.StableSort([](const FAssetPredicate& A, const FAssetPredicate& B)
+	{
+		return A.Cost < B.Cost;
+	});
+
+	return true;
+}
+
+//Splits on whitespace outside of double quotes, "/Game/My Folder" stays one token with its spaces
+//and a quoted "AND" is a value, not a separator. The quotes are kept and removed by ParseValue
+bool FAssetFilterQuery::Tokenize(const FString& QueryString, TArray<FString>& OutTokens, FString& OutErrorMessage)
+{
+	OutTokens.Reset();
+
+	FString CurrentToken;
+	bool bInQuotes = false;
+
+	for(const TCHAR Character:QueryString)
+	{
+		if(Character==TEXT('"'))
+		{
+			bInQuotes = !bInQuotes;
+		}
+		else if(!bInQuotes && FChar::IsWhitespace(Character))
+		{
+			if(!CurrentToken.IsEmpty()) OutTokens.Add(MoveTemp(CurrentToken));
+
+			CurrentToken.Reset();
+			continue;
+		}
+
+		CurrentToken.AppendChar(Character);
+	}
+
+	if(bInQuotes)
+	{
+		OutErrorMessage = TEXT("Missing closing quote in \"") + CurrentToken + TEXT("\"");
+		return false;
+	}
+
+	if(!CurrentToken.IsEmpty()) OutTokens.Add(MoveTemp(CurrentToken));
+
+	return true;
+}
+
+bool FAssetFilterQuery::ParseValue(FString ValueText, FString& OutValue)
+{
+	ValueText.TrimStartAndEndInline();
+
+	if(ValueText.Len()>=2 && ValueText.StartsWith(TEXT("\"")) && ValueText.EndsWith(TEXT("\"")))
+	{
+		ValueText.MidInline(1,ValueText.Len()-2);
+	}
+
+	//Quotes left over are not around the whole value, like name=My"Asset
+	if(ValueText.IsEmpty() || ValueText.Contains(TEXT("\""))) return false;
+
+	OutValue = MoveTemp(ValueText);
+
+	return true;
+}
+
+bool FAssetFilterQuery::CompileClause(FString Clause, FString& OutErrorMessage)
+{
+	FAssetPredicate Predicate;
+
+	if(Clause.StartsWith(TEXT("NOT "),ESearchCase::IgnoreCase))
+	{
+		Predicate.bNegate = true;
+		Clause.RightChopInline(4);
+		Clause.TrimStartInline();
+	}
+
+	IAssetRegistry* AssetRegistry =
+	&FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	if(Clause.Equals(TEXT("unused"),ESearchCase::IgnoreCase))
+	{
+		bNeedsReferencers = true;
+
+		Predicate.Cost = EPredicateCost::EPC_References;
+		Predicate.Test = [AssetRegistry](const FAssetData& AssetData, const FPredicateContext&)
+		{
+			TArray<FName> AssetReferencers;
+			AssetRegistry->GetReferencers(AssetData.PackageName,AssetReferencers);
+
+			return AssetReferencers.Num()==0;
+		};
+	}
+	else if(Clause.Equals(TEXT("samename"),ESearchCase::IgnoreCase))
+	{
+		bNeedsDuplicatedNames = true;
+
+		Predicate.Cost = EPredicateCost::EPC_SetLookup;
+		Predicate.Test = [](const FAssetData& AssetData, const FPredicateContext& Context)
+		{
+			return Context.DuplicatedAssetNames.Contains(AssetData.AssetName);
+		};
+	}
+	else if(Clause.StartsWith(TEXT("class"),ESearchCase::IgnoreCase))
+	{
+		//Operator right after the keyword, so an = inside a quoted value is never taken for it
+		FString Operand = Clause.RightChop(5).TrimStart();
+		FString ClassName;
+		bool bNotEqual = false;
+
+		if(Operand.RemoveFromStart(TEXT("!=")))
+		{
+			bNotEqual = true;
+		}
+		else if(!Operand.RemoveFromStart(TEXT("=")))
+		{
+			OutErrorMessage = TEXT("Expected class=Name in \"") + Clause + TEXT("\"");
+			return false;
+		}
+
+		if(!ParseValue(Operand,ClassName))
+		{
+			OutErrorMessage = TEXT("Invalid class name in \"") + Clause + TEXT("\"");
+			return false;
+		}
+
+		//Resolve the class hierarchy once here, so evaluation is only a set lookup
+		TSet<FName> AcceptedClassNames;
+		AcceptedClassNames.Add(FName(*ClassName));
+
+		for(TObjectIterator<UClass> ClassIt; ClassIt; ++ClassIt)
+		{
+			if(ClassIt->GetName().Equals(ClassName,ESearchCase::IgnoreCase))
+			{
+				TArray<UClass*> DerivedClasses;
+				GetDerivedClasses(*ClassIt,DerivedClasses,true);
+
+				AcceptedClassNames.Add(ClassIt->GetFName());
+
+				for(const UClass* DerivedClass:DerivedClasses)
+				{
+					AcceptedClassNames.Add(DerivedClass->GetFName());
+				}
+			}
+		}
+
+		if(bNotEqual) Predicate.bNegate = !Predicate.bNegate;
+
+		Predicate.Cost = EPredicateCost::EPC_Metadata;
+		Predicate.Test = [AcceptedClassNames](const FAssetData& AssetData, const FPredicateContext&)
+		{
+			return AcceptedClassNames.Contains(AssetData.AssetClass);
+		};
+	}
+	else if(Clause.StartsWith(TEXT("name"),ESearchCase::IgnoreCase))
+	{
+		FString Operand = Clause.RightChop(4).TrimStart();
+		FString NameToMatch;
+
+		const bool bContains = Operand.RemoveFromStart(TEXT("~"));
+
+		if(!bContains && !Operand.RemoveFromStart(TEXT("=")))
+		{
+			OutErrorMessage = TEXT("Expected name=Text or name~Text in \"") + Clause + TEXT("\"");
+			return false;
+		}
+
+		if(!ParseValue(Operand,NameToMatch))
+		{
+			OutErrorMessage = TEXT("Invalid name in \"") + Clause + TEXT("\", quote names with spaces");
+			return false;
+		}
+
+		if(bContains)
+		{
+			Predicate.Test = [NameToMatch](const FAssetData& AssetData, const FPredicateContext&)
+			{
+				return AssetData.AssetName.ToString().Contains(NameToMatch);
+			};
+		}
+		else
+		{
+			const FName ExactName(*NameToMatch);
+
+			Predicate.Test = [ExactName](const FAssetData& AssetData, const FPredicateContext&)
+			{
+				return AssetData.AssetName == ExactName;
+			};
+		}
+
+		Predicate.Cost = EPredicateCost::EPC_Metadata;
+	}
+	else if(Clause.StartsWith(TEXT("path"),ESearchCase::IgnoreCase))
+	{
+		FString Operand = Clause.RightChop(4).TrimStart();
+		FString FolderPath;
+
+		if(!Operand.RemoveFromStart(TEXT("under "),ESearchCase::IgnoreCase) && !Operand.RemoveFromStart(TEXT("=")))
+		{
+			OutErrorMessage = TEXT("Expected path under /Game/Folder in \"") + Clause + TEXT("\"");
+			return false;
+		}
+
+		if(!ParseValue(Operand,FolderPath))
+		{
+			OutErrorMessage = TEXT("Invalid folder in \"") + Clause + TEXT("\", quote folders with spaces");
+			return false;
+		}
+
+		FolderPath.RemoveFromEnd(TEXT("/"));
+
+		const FString FolderPathWithSlash = FolderPath + TEXT("/");
+
+		Predicate.Cost = EPredicateCost::EPC_Metadata;
+		Predicate.Test = [FolderPath,FolderPathWithSlash](const FAssetData& AssetData, const FPredicateContext&)
+		{
+			const FString PackagePath = AssetData.PackagePath.ToString();
+
+			return PackagePath.Equals(FolderPath,ESearchCase::IgnoreCase) ||
+			PackagePath.StartsWith(FolderPathWithSlash,ESearchCase::IgnoreCase);
+		};
+	}
+	else if(Clause.StartsWith(TEXT("size"),ESearchCase::IgnoreCase))
+	{
+		FString SizeText;
+		bool bGreaterThan = true;
+
+		if(!Clause.Split(TEXT(">"),nullptr,&SizeText))
+		{
+			bGreaterThan = false;
+
+			if(!Clause.Split(TEXT("<"),nullptr,&SizeText))
+			{
+				OutErrorMessage = TEXT("Expected size>4MB or size<4MB in \"") + Clause + TEXT("\"");
+				return false;
+			}
+		}
+
+		int64 SizeInBytes = 0;
+
+		if(!ParseSizeInBytes(SizeText,SizeInBytes))
+		{
+			OutErrorMessage = TEXT("Invalid size in \"") + Clause + TEXT("\"");
+			return false;
+		}
+
+		Predicate.Cost = EPredicateCost::EPC_PackageData;
+		Predicate.Test = [AssetRegistry,SizeInBytes,bGreaterThan](const FAssetData& AssetData, const FPredicateContext&)
+		{
+			const TOptional<FAssetPackageData> PackageData = AssetRegistry->GetAssetPackageDataCopy(AssetData.PackageName);
+
+			if(!PackageData.IsSet()) return false;
+
+			return bGreaterThan ? PackageData->DiskSize > SizeInBytes : PackageData->DiskSize < SizeInBytes;
+		};
+	}
+	else
+	{
+		OutErrorMessage = TEXT("Unknown condition \"") + Clause + TEXT("\"");
+		return false;
+	}
+
+	Predicates.Add(MoveTemp(Predicate));
+
+	return true;
+}
+
+bool FAssetFilterQuery::ParseSizeInBytes(FString SizeText, int64& OutSizeInBytes)
+{
+	SizeText.TrimStartAndEndInline();
+
+	int64 Multiplier = 1;
+
+	if(SizeText.RemoveFromEnd(TEXT("GB"),ESearchCase::IgnoreCase)) Multiplier = 1024ll*1024*1024;
+	else if(SizeText.RemoveFromEnd(TEXT("MB"),ESearchCase::IgnoreCase)) Multiplier = 1024*1024;
+	else if(SizeText.RemoveFromEnd(TEXT("KB"),ESearchCase::IgnoreCase)) Multiplier = 1024;
+	else SizeText.RemoveFromEnd(TEXT("B"),ESearchCase::IgnoreCase);
+
+	SizeText.TrimStartAndEndInline();
+
+	if(SizeText.IsEmpty() || !SizeText.IsNumeric()) return false;
+
+	OutSizeInBytes = static_cast<int64>(FCString::Atod(*SizeText) * Multiplier);
+
+	return true;
+}
+
+void FAssetFilterQuery::Evaluate(const TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter,
+TArray<TSharedPtr<FAssetData>>& OutFilteredAssetsData) const
+{
+	OutFilteredAssetsData.Empty();
+
+	if(IsEmpty())
+	{
+		OutFilteredAssetsData = AssetsDataToFilter;
+		return;
+	}
+
+	FPredicateContext Context;
+
+	if(bNeedsDuplicatedNames)
+	{
+		TSet<FName> SeenAssetNames;
+
+		for(const TSharedPtr<FAssetData>& DataSharedPtr:AssetsDataToFilter)
+		{
+			if(!DataSharedPtr.IsValid()) continue;
+
+			bool bAlreadySeen = false;
+			SeenAssetNames.Add(DataSharedPtr->AssetName,&bAlreadySeen);
+
+			if(bAlreadySeen)
+			{
+				Context.DuplicatedAssetNames.Add(DataSharedPtr->AssetName);
+			}
+		}
+	}
+
+	TArray<bool> PassedFilter;
+	PassedFilter.SetNumZeroed(AssetsDataToFilter.Num());
+
+	const int32 NumOfChunks = FMath::DivideAndRoundUp(AssetsDataToFilter.Num(),FilterChunkSize);
+
+	ParallelFor(NumOfChunks,[&](int32 ChunkIndex)
+	{
+		const int32 ChunkStart = ChunkIndex*FilterChunkSize;
+		const int32 ChunkEnd = FMath::Min(ChunkStart+FilterChunkSize,AssetsDataToFilter.Num());
+
+		for(int32 AssetIndex = ChunkStart; AssetIndex<ChunkEnd; AssetIndex++)
+		{
+			const TSharedPtr<FAssetData>& DataSharedPtr = AssetsDataToFilter[AssetIndex];
+
+			if(!DataSharedPtr.IsValid()) continue;
+
+			bool bPassed = true;
+
+			for(const FAssetPredicate& Predicate:Predicates)
+			{
+				if(Predicate.Test(*DataSharedPtr,Context) == Predicate.bNegate)
+				{
+					bPassed = false;
+					break;
+				}
+			}
+
+			PassedFilter[AssetIndex] = bPassed;
+		}
+	});
+
+	for(int32 AssetIndex = 0; AssetIndex<AssetsDataToFilter.Num(); AssetIndex++)
+	{
+		if(PassedFilter[AssetIndex])
+		{
+			OutFilteredAssetsData.Add(AssetsDataToFilter[AssetIndex]);
+		}
+	}
+}
@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Commandlets/NamingConventionAuditCommandlet.h"
+#include "AssetActions/NamingConventionAudit.h"
+#include "AssetRegistryModule.h"
+#include "FileHelpers.h"
+
+UNamingConventionAuditCommandlet::UNamingConventionAuditCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UNamingConventionAuditCommandlet::Main(const FString& Params)
+{
+	FString FolderPathToAudit = TEXT("/Game");
+	FParse::Value(*Params,TEXT("Path="),FolderPathToAudit);
+
+	const bool bShouldFix = FParse::Param(*Params,TEXT("Fix"));
+
+	//No editor running, so the registry has to finish its scan before it can be queried
+	IAssetRegistry& AssetRegistry =
+	FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	TArray<FNamingViolation> Violations;
+	FNamingConventionAudit::FindViolations({FolderPathToAudit},Violations);
+
+	for(const FNamingViolation& Violation:Violations)
+	{
+		UE_LOG(LogTemp, Display, TEXT("%s should be named %s"),
+		*Violation.AssetData.ObjectPath.ToString(),*Violation.SuggestedName);
+	}
+
+	const FString ReportFilePath = FNamingConventionAudit::WriteReport(Violations);
+
+	UE_LOG(LogTemp, Display, TEXT("Found %d naming convention violations under %s, report written to %s"),
+	Violations.Num(),*FolderPathToAudit,*ReportFilePath);
+
+	if(bShouldFix && Violations.Num()>0)
+	{
+		const uint32 Counter = FNamingConventionAudit::FixViolations(Violations);
+
+		//Renames leave the referencing packages dirty, nobody is there to save them later
+		UEditorLoadingAndSavingUtils::SaveDirtyPackages(true,true);
+
+		UE_LOG(LogTemp, Display, TEXT("Renamed %u assets"),Counter);
+	}
+
+	return 0;
+}
@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CustomSettings/SuperManagerSettings.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "Materials/MaterialFunctionInterface.h"
+#include "Particles/ParticleSystem.h"
+#include "Sound/SoundCue.h"
+#include "Sound/SoundWave.h"
+#include "Engine/Texture.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/Blueprint.h"
+#include "Animation/AnimBlueprint.h"
+#include "NiagaraSystem.h"
+#include "NiagaraEmitter.h"
+
+USuperManagerSettings::USuperManagerSettings()
+{
+	AssetPrefixes = 
+	{
+		{UBlueprint::StaticClass(),TEXT("BP_")},
+		{UAnimBlueprint::StaticClass(),TEXT("ABP_")},
+		{TSoftClassPtr<UObject>(FSoftObjectPath(TEXT("/Script/UMGEditor.WidgetBlueprint"))),TEXT("WBP_")},
+		{UStaticMesh::StaticClass(),TEXT("SM_")},
+		{USkeletalMesh::StaticClass(),TEXT("SK_")},
+		{UMaterial::StaticClass(), TEXT("M_")},
+		{UMaterialInstanceConstant::StaticClass(),TEXT("MI_")},
+		{UMaterialFunctionInterface::StaticClass(), TEXT("MF_")},
+		{UParticleSystem::StaticClass(), TEXT("PS_")},
+		{USoundCue::StaticClass(), TEXT("SC_")},
+		{USoundWave::StaticClass(), TEXT("SW_")},
+		{UTexture::StaticClass(), TEXT("T_")},
+		{UNiagaraSystem::StaticClass(), TEXT("NS_")},
+		{UNiagaraEmitter::StaticClass(), TEXT("NE_")}
+	};
+}
+
+#if WITH_EDITOR
+void USuperManagerSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	++PrefixRulesRevision;
+}
+#endif
@@ -4,26 +4,51 @@
 #include "SlateBasics.h"
 #include "DebugHeader.h"
 #include "SuperManager.h"
+#include "AssetThumbnail.h"
+#include "AssetRegistryModule.h"
 
 #define ListAll TEXT("List All Available Assets")
 #define ListUnused TEXT("List Unused Assets")
 #define ListSameName TEXT("List Assets With Same Name ")
 
+#define ThumbnailResolution 64
+#define ThumbnailPoolMemoryBudgetInMB 8
+
+//Filter queries the listing options above are shortcuts for
+#define ListAllQuery TEXT("")
+#define ListUnusedQuery TEXT("unused")
+#define ListSameNameQuery TEXT("samename")
+
 void SAdvanceDeletionTab::Construct(const FArguments & InArgs)
 {
 	bCanSupportFocus = true;
 	
 	StoredAssetsData = InArgs._AssetsDataToStore;
 	DisplayedAssetsData = StoredAssetsData;
+	SelectedFolder = InArgs._CurrentSelectedFolder;
+
+	StoredAssetsDataByObjectPath.Empty();
+
+	for(const TSharedPtr<FAssetData>& DataSharedPtr:StoredAssetsData)
+	{
+		StoredAssetsDataByObjectPath.Add(DataSharedPtr->ObjectPath,DataSharedPtr);
+	}
+
+	SubscribeToAssetRegistry();
 
-	CheckBoxesArray.Empty();
-	AssetsDataToDeleteArray.Empty();
+	AssetsDataToDelete.Empty();
 	ComboBoxSourceItems.Empty();
 
 	ComboBoxSourceItems.Add(MakeShared<FString>(ListAll));
 	ComboBoxSourceItems.Add(MakeShared<FString>(ListUnused));
 	ComboBoxSourceItems.Add(MakeShared<FString>(ListSameName));
 
+	//Pool size derived from the memory budget, every thumbnail is a BGRA8 render target
+	const uint32 NumOfPooledThumbnails =
+	(ThumbnailPoolMemoryBudgetInMB * 1024 * 1024) / (ThumbnailResolution * ThumbnailResolution * 4);
+
+	AssetThumbnailPool = MakeShared<FAssetThumbnailPool>(NumOfPooledThumbnails);
+
 	FSlateFontInfo TitleTextFont = GetEmboseedTextFont();
 	TitleTextFont.Size = 30;
 
@@ -71,16 +96,19 @@ void SAdvanceDeletionTab::Construct(const FArguments & InArgs)
 			]
 		]
 
-		//Third slot for the asset list
+		//Slot for typing a custom filter query
 		+SVerticalBox::Slot()
-		.VAlign(VAlign_Fill)
+		.AutoHeight()
+		.Padding(0.f,5.f)
 		[
-			SNew(SScrollBox)
+			ConstructFilterQueryTextBox()
+		]
 
-			+SScrollBox::Slot()
-			[
-				ConstructAssetListView()
-			]
+		//Third slot for the asset list, the list view scrolls itself so it only generates visible rows
+		+SVerticalBox::Slot()
+		.VAlign(VAlign_Fill)
+		[
+			ConstructAssetListView()
 		]
 
 		//Fourth slot for 3 buttons
@@ -119,7 +147,7 @@ void SAdvanceDeletionTab::Construct(const FArguments & InArgs)
 TSharedRef<SListView<TSharedPtr<FAssetData>>> SAdvanceDeletionTab::ConstructAssetListView()
 {	
 	ConstructedAssetListView = SNew(SListView< TSharedPtr <FAssetData> >)
-	.ItemHeight(24.f)
+	.ItemHeight(ThumbnailResolution + 10.f)
 	.ListItemsSource(&DisplayedAssetsData)
 	.OnGenerateRow(this,&SAdvanceDeletionTab::OnGenerateRowForList)
 	.OnMouseButtonClick(this,&SAdvanceDeletionTab::OnRowWidgetMoustButtonClicked);
@@ -129,8 +157,7 @@ TSharedRef<SListView<TSharedPtr<FAssetData>>> SAdvanceDeletionTab::ConstructAsse
 
 void SAdvanceDeletionTab::RefreshAssetListView()
 {	
-	CheckBoxesArray.Empty();
-	AssetsDataToDeleteArray.Empty();
+	AssetsDataToDelete.Empty();
 
 	if(ConstructedAssetListView.IsValid())
 	{
@@ -170,28 +197,24 @@ ESelectInfo::Type InSelectInfo)
 
 	ComboDiplayTextBlock->SetText(FText::FromString(*SelectedOption.Get()));
 
-	FSuperManagerModule& SuperManagerModule = 
-	FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	//Every listing option is a preset filter query
+	FString PresetQuery = ListAllQuery;
 
-	//Pass data for our module to filter based on the selected option
-	if(*SelectedOption.Get() == ListAll)
+	if(*SelectedOption.Get() == ListUnused)
 	{
-		//List all stored asset data
-		DisplayedAssetsData = StoredAssetsData;
-		RefreshAssetListView();
+		PresetQuery = ListUnusedQuery;
 	}
-	else if(*SelectedOption.Get() == ListUnused)
+	else if(*SelectedOption.Get() == ListSameName)
 	{
-		//List all unused assets
-		SuperManagerModule.ListUnusedAssetsForAssetList(StoredAssetsData,DisplayedAssetsData);
-		RefreshAssetListView();
+		PresetQuery = ListSameNameQuery;
 	}
-	else if(*SelectedOption.Get() == ListSameName)
+
+	if(FilterQueryTextBox.IsValid())
 	{
-		//List out all assets with same name
-		SuperManagerModule.ListSameNameAssetsForAssetList(StoredAssetsData,DisplayedAssetsData);
-		RefreshAssetListView();
+		FilterQueryTextBox->SetText(FText::FromString(PresetQuery));
 	}
+
+	ApplyFilterQuery(PresetQuery);
 }
 
 TSharedRef<STextBlock> SAdvanceDeletionTab::ConstructComboHelpTexts(const FString & TextContent, 
@@ -208,6 +231,292 @@ ETextJustify::Type TextJustify)
 
 #pragma endregion
 
+#pragma region FilterQueryForListingCondition
+
+TSharedRef<SEditableTextBox> SAdvanceDeletionTab::ConstructFilterQueryTextBox()
+{
+	SAssignNew(FilterQueryTextBox,SEditableTextBox)
+	.HintText(FText::FromString(TEXT("Filter, e.g. class=Texture2D AND unused AND size>4MB AND path under /Game/Old")))
+	.OnTextCommitted(this,&SAdvanceDeletionTab::OnFilterQueryCommitted);
+
+	return FilterQueryTextBox.ToSharedRef();
+}
+
+void SAdvanceDeletionTab::OnFilterQueryCommitted(const FText& CommittedText, ETextCommit::Type CommitType)
+{
+	if(CommitType != ETextCommit::OnEnter) return;
+
+	ApplyFilterQuery(CommittedText.ToString());
+}
+
+void SAdvanceDeletionTab::ApplyFilterQuery(const FString& FilterQuery)
+{
+	FAssetFilterQuery CompiledFilterQuery;
+	FString ErrorMessage;
+
+	if(!CompiledFilterQuery.Compile(FilterQuery,ErrorMessage))
+	{
+		//Stays on the box until a query compiles, the list keeps the last valid filter
+		if(FilterQueryTextBox.IsValid())
+		{
+			FilterQueryTextBox->SetError(TEXT("Invalid filter: ") + ErrorMessage);
+		}
+
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok,TEXT("Invalid filter: ") + ErrorMessage);
+		return;
+	}
+
+	if(FilterQueryTextBox.IsValid())
+	{
+		FilterQueryTextBox->SetError(FText::GetEmpty());
+	}
+
+	//Kept compiled so live updates can filter newly added assets
+	CurrentFilterQuery = MoveTemp(CompiledFilterQuery);
+	CurrentFilterQuery.Evaluate(StoredAssetsData,DisplayedAssetsData);
+
+	RefreshAssetListView();
+}
+
+#pragma endregion
+
+#pragma region LiveUpdateFromAssetRegistry
+
+SAdvanceDeletionTab::~SAdvanceDeletionTab()
+{
+	UnsubscribeFromAssetRegistry();
+}
+
+void SAdvanceDeletionTab::SubscribeToAssetRegistry()
+{
+	IAssetRegistry& AssetRegistry =
+	FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	AssetRegistry.OnAssetAdded().AddSP(this,&SAdvanceDeletionTab::OnRegistryAssetAdded);
+	AssetRegistry.OnAssetRemoved().AddSP(this,&SAdvanceDeletionTab::OnRegistryAssetRemoved);
+	AssetRegistry.OnAssetRenamed().AddSP(this,&SAdvanceDeletionTab::OnRegistryAssetRenamed);
+}
+
+void SAdvanceDeletionTab::UnsubscribeFromAssetRegistry()
+{
+	//Registry may already be gone when the editor shuts down with the tab open
+	if(FAssetRegistryModule* AssetRegistryModule = 
+	FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+
+		AssetRegistry.OnAssetAdded().RemoveAll(this);
+		AssetRegistry.OnAssetRemoved().RemoveAll(this);
+		AssetRegistry.OnAssetRenamed().RemoveAll(this);
+	}
+}
+
+void SAdvanceDeletionTab::OnRegistryAssetAdded(const FAssetData& AddedAssetData)
+{
+	if(!IsAssetUnderSelectedFolder(AddedAssetData)) return;
+
+	PendingRemovedObjectPaths.Remove(AddedAssetData.ObjectPath);
+	PendingAddedAssetsData.Add(AddedAssetData);
+
+	ScheduleFlushPendingAssetChanges();
+}
+
+void SAdvanceDeletionTab::OnRegistryAssetRemoved(const FAssetData& RemovedAssetData)
+{
+	PendingAddedAssetsData.RemoveAll([&RemovedAssetData](const FAssetData& PendingData)
+	{
+		return PendingData.ObjectPath == RemovedAssetData.ObjectPath;
+	});
+
+	if(!StoredAssetsDataByObjectPath.Contains(RemovedAssetData.ObjectPath)) return;
+
+	PendingRemovedObjectPaths.Add(RemovedAssetData.ObjectPath);
+
+	ScheduleFlushPendingAssetChanges();
+}
+
+void SAdvanceDeletionTab::OnRegistryAssetRenamed(const FAssetData& RenamedAssetData, const FString& OldObjectPath)
+{
+	//A rename is a remove of the old entry and an add of the new one, which may now be outside the folder
+	const FName OldObjectPathName(*OldObjectPath);
+
+	if(StoredAssetsDataByObjectPath.Contains(OldObjectPathName))
+	{
+		PendingRemovedObjectPaths.Add(OldObjectPathName);
+		ScheduleFlushPendingAssetChanges();
+	}
+
+	OnRegistryAssetAdded(RenamedAssetData);
+}
+
+bool SAdvanceDeletionTab::IsAssetUnderSelectedFolder(const FAssetData& AssetData) const
+{
+	const FString PackagePath = AssetData.PackagePath.ToString();
+
+	if(!PackagePath.Equals(SelectedFolder) && !PackagePath.StartsWith(SelectedFolder + TEXT("/"))) return false;
+
+	FSuperManagerModule& SuperManagerModule = 
+	FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+
+	return SuperManagerModule.ShouldListAssetPath(AssetData.ObjectPath.ToString());
+}
+
+void SAdvanceDeletionTab::ScheduleFlushPendingAssetChanges()
+{
+	if(bFlushScheduled) return;
+
+	bFlushScheduled = true;
+
+	RegisterActiveTimer(0.f,
+	FWidgetActiveTimerDelegate::CreateSP(this,&SAdvanceDeletionTab::FlushPendingAssetChanges));
+}
+
+EActiveTimerReturnType SAdvanceDeletionTab::FlushPendingAssetChanges(double InCurrentTime, float InDeltaTime)
+{
+	bFlushScheduled = false;
+
+	auto IsPendingRemoval = [this](const TSharedPtr<FAssetData>& Data)
+	{
+		return Data.IsValid() && PendingRemovedObjectPaths.Contains(Data->ObjectPath);
+	};
+
+	const bool bAssetsRemoved = PendingRemovedObjectPaths.Num()>0;
+
+	if(bAssetsRemoved)
+	{
+		StoredAssetsData.RemoveAll(IsPendingRemoval);
+		DisplayedAssetsData.RemoveAll(IsPendingRemoval);
+
+		for(const FName& RemovedObjectPath:PendingRemovedObjectPaths)
+		{
+			if(const TSharedPtr<FAssetData>* RemovedData = StoredAssetsDataByObjectPath.Find(RemovedObjectPath))
+			{
+				AssetsDataToDelete.Remove(*RemovedData);
+			}
+
+			StoredAssetsDataByObjectPath.Remove(RemovedObjectPath);
+		}
+	}
+
+	TArray< TSharedPtr <FAssetData> > AddedAssetsData;
+
+	for(const FAssetData& PendingData:PendingAddedAssetsData)
+	{
+		if(StoredAssetsDataByObjectPath.Contains(PendingData.ObjectPath)) continue;
+
+		TSharedPtr<FAssetData> AddedData = MakeShared<FAssetData>(PendingData);
+
+		StoredAssetsData.Add(AddedData);
+		StoredAssetsDataByObjectPath.Add(AddedData->ObjectPath,AddedData);
+		AddedAssetsData.Add(AddedData);
+	}
+
+	PendingAddedAssetsData.Empty();
+	PendingRemovedObjectPaths.Empty();
+
+	if(CurrentFilterQuery.DependsOnWholeList() || (bAssetsRemoved && CurrentFilterQuery.DependsOnReferencers()))
+	{
+		//Same name matches can change for assets that were already listed, and removed
+		//assets may have been the last referencers of assets that were not listed as unused
+		CurrentFilterQuery.Evaluate(StoredAssetsData,DisplayedAssetsData);
+
+		RemoveHiddenAssetsFromDeletion();
+	}
+	else if(AddedAssetsData.Num()>0)
+	{
+		TArray< TSharedPtr <FAssetData> > AddedDisplayedAssetsData;
+		CurrentFilterQuery.Evaluate(AddedAssetsData,AddedDisplayedAssetsData);
+
+		DisplayedAssetsData.Append(AddedDisplayedAssetsData);
+
+		//Added assets can reference listed unused assets, which are then in use
+		if(CurrentFilterQuery.DependsOnReferencers())
+		{
+			ReevaluateAssetsReferencedBy(AddedAssetsData);
+		}
+	}
+
+	//Only refresh the rows, the checked assets stay checked
+	if(ConstructedAssetListView.IsValid())
+	{
+		ConstructedAssetListView->RequestListRefresh();
+	}
+
+	return EActiveTimerReturnType::Stop;
+}
+
+void SAdvanceDeletionTab::ReevaluateAssetsReferencedBy(const TArray< TSharedPtr <FAssetData> >& ReferencingAssetsData)
+{
+	IAssetRegistry& AssetRegistry =
+	FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	TSet<FName> ReferencedPackageNames;
+
+	for(const TSharedPtr<FAssetData>& ReferencingData:ReferencingAssetsData)
+	{
+		TArray<FName> Dependencies;
+		AssetRegistry.GetDependencies(ReferencingData->PackageName,Dependencies);
+
+		ReferencedPackageNames.Append(Dependencies);
+	}
+
+	if(ReferencedPackageNames.Num()==0) return;
+
+	TArray< TSharedPtr <FAssetData> > ReferencedAssetsData;
+
+	for(const TSharedPtr<FAssetData>& DataSharedPtr:StoredAssetsData)
+	{
+		if(ReferencedPackageNames.Contains(DataSharedPtr->PackageName))
+		{
+			ReferencedAssetsData.Add(DataSharedPtr);
+		}
+	}
+
+	if(ReferencedAssetsData.Num()==0) return;
+
+	TArray< TSharedPtr <FAssetData> > PassedAssetsData;
+	CurrentFilterQuery.Evaluate(ReferencedAssetsData,PassedAssetsData);
+
+	const TSet< TSharedPtr <FAssetData> > ReferencedAssetsDataSet(ReferencedAssetsData);
+	const TSet< TSharedPtr <FAssetData> > PassedAssetsDataSet(PassedAssetsData);
+
+	DisplayedAssetsData.RemoveAll([&](const TSharedPtr<FAssetData>& DataSharedPtr)
+	{
+		return ReferencedAssetsDataSet.Contains(DataSharedPtr) && !PassedAssetsDataSet.Contains(DataSharedPtr);
+	});
+
+	//A negated query like NOT unused can start to list assets that were hidden
+	const TSet< TSharedPtr <FAssetData> > DisplayedAssetsDataSet(DisplayedAssetsData);
+
+	for(const TSharedPtr<FAssetData>& PassedData:PassedAssetsData)
+	{
+		if(!DisplayedAssetsDataSet.Contains(PassedData))
+		{
+			DisplayedAssetsData.Add(PassedData);
+		}
+	}
+
+	RemoveHiddenAssetsFromDeletion();
+}
+
+//Delete All only deletes what the list shows, an asset filtered out after it was checked is unchecked
+void SAdvanceDeletionTab::RemoveHiddenAssetsFromDeletion()
+{
+	if(AssetsDataToDelete.Num()==0) return;
+
+	const TSet< TSharedPtr <FAssetData> > DisplayedAssetsDataSet(DisplayedAssetsData);
+
+	for(auto SetIt = AssetsDataToDelete.CreateIterator(); SetIt; ++SetIt)
+	{
+		if(!DisplayedAssetsDataSet.Contains(*SetIt))
+		{
+			SetIt.RemoveCurrent();
+		}
+	}
+}
+
+#pragma endregion
+
 #pragma region RowWidgetForAssetListView
 
 TSharedRef<ITableRow> SAdvanceDeletionTab::OnGenerateRowForList(TSharedPtr<FAssetData> AssetDataToDisplay, const TSharedRef<STableViewBase>& OwnerTable)
@@ -236,6 +545,16 @@ TSharedRef<ITableRow> SAdvanceDeletionTab::OnGenerateRowForList(TSharedPtr<FAsse
 		[
 			ConstructCheckBox(AssetDataToDisplay)
 		]
+
+		//Slot for the asset thumbnail
+		+SHorizontalBox::Slot()
+		.HAlign(HAlign_Left)
+		.VAlign(VAlign_Center)
+		.AutoWidth()
+		.Padding(FMargin(0.f,0.f,10.f,0.f))
+		[
+			ConstructThumbnailForRowWidget(AssetDataToDisplay)
+		]
 				
 		//Second slot for displaying asset class name
 		+SHorizontalBox::Slot()
@@ -279,30 +598,31 @@ TSharedRef<SCheckBox> SAdvanceDeletionTab::ConstructCheckBox(const TSharedPtr<FA
 {	
 	TSharedRef<SCheckBox> ConstructedCheckBox = SNew(SCheckBox)
 	.Type(ESlateCheckBoxType::CheckBox)
+	.IsChecked(this,&SAdvanceDeletionTab::GetCheckBoxState,AssetDataToDisplay)
 	.OnCheckStateChanged(this,&SAdvanceDeletionTab::OnCheckBoxStateChanged,AssetDataToDisplay)
 	.Visibility(EVisibility::Visible);
 
-	CheckBoxesArray.Add(ConstructedCheckBox);
-
 	return ConstructedCheckBox;
 }
 
+ECheckBoxState SAdvanceDeletionTab::GetCheckBoxState(TSharedPtr<FAssetData> AssetData) const
+{
+	return AssetsDataToDelete.Contains(AssetData) ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+}
+
 void SAdvanceDeletionTab::OnCheckBoxStateChanged(ECheckBoxState NewState, TSharedPtr<FAssetData> AssetData)
 {	
 	switch(NewState)
 	{
 	case ECheckBoxState::Unchecked:
 
-		if(AssetsDataToDeleteArray.Contains(AssetData))
-		{
-			AssetsDataToDeleteArray.Remove(AssetData);
-		}
+		AssetsDataToDelete.Remove(AssetData);
 
 		break;
 
 	case ECheckBoxState::Checked:
 
-		AssetsDataToDeleteArray.AddUnique(AssetData);
+		AssetsDataToDelete.Add(AssetData);
 
 		break;
 
@@ -326,6 +646,25 @@ const FSlateFontInfo & FontToUse)
 	return ConstructedTextBlock;
 }
 
+//Rows are only generated for visible items, so thumbnails are requested lazily while scrolling
+TSharedRef<SWidget> SAdvanceDeletionTab::ConstructThumbnailForRowWidget(const TSharedPtr<FAssetData>& AssetDataToDisplay)
+{
+	TSharedRef<FAssetThumbnail> AssetThumbnail = 
+	MakeShared<FAssetThumbnail>(*AssetDataToDisplay.Get(),ThumbnailResolution,ThumbnailResolution,AssetThumbnailPool);
+
+	//No real time rendering, unloaded assets use the thumbnail cached in their package instead of being loaded
+	FAssetThumbnailConfig ThumbnailConfig;
+	ThumbnailConfig.bAllowRealTimeOnHover = false;
+	ThumbnailConfig.bAllowFadeIn = true;
+
+	return SNew(SBox)
+	.WidthOverride(ThumbnailResolution)
+	.HeightOverride(ThumbnailResolution)
+	[
+		AssetThumbnail->MakeThumbnailWidget(ThumbnailConfig)
+	];
+}
+
 TSharedRef<SButton> SAdvanceDeletionTab::ConstructButtonForRowWidget(const TSharedPtr<FAssetData>& AssetDataToDisplay)
 {
 	TSharedRef<SButton> ConstructedButton = SNew(SButton)
@@ -379,7 +718,7 @@ TSharedRef<SButton> SAdvanceDeletionTab::ConstructDeleteAllButton()
 
 FReply SAdvanceDeletionTab::OnDeleteAllButtonClicked()
 {	
-	if(AssetsDataToDeleteArray.Num()==0)
+	if(AssetsDataToDelete.Num()==0)
 	{
 		DebugHeader::ShowMsgDialog(EAppMsgType::Ok,TEXT("No asset currently selected"));
 		return FReply::Handled();
@@ -387,7 +726,7 @@ FReply SAdvanceDeletionTab::OnDeleteAllButtonClicked()
 
 	TArray<FAssetData> AssetDataToDelete;
 
-	for(const TSharedPtr<FAssetData>& Data:AssetsDataToDeleteArray)
+	for(const TSharedPtr<FAssetData>& Data:AssetsDataToDelete)
 	{
 		AssetDataToDelete.Add(*Data.Get());
 	}
@@ -399,18 +738,18 @@ FReply SAdvanceDeletionTab::OnDeleteAllButtonClicked()
 
 	 if(bAssetsDeleted)
 	 {
-		for(const TSharedPtr<FAssetData>& DeletedData:AssetsDataToDeleteArray)
-		{	
-			//Updating the stored assets data
-			if(StoredAssetsData.Contains(DeletedData))
-			{
-				StoredAssetsData.Remove(DeletedData);
-			}
+		//Updating the stored assets data
+		auto IsDeleted = [this](const TSharedPtr<FAssetData>& Data)
+		{
+			return AssetsDataToDelete.Contains(Data);
+		};
 
-			if(DisplayedAssetsData.Contains(DeletedData))
-			{
-				DisplayedAssetsData.Remove(DeletedData);
-			}
+		StoredAssetsData.RemoveAll(IsDeleted);
+		DisplayedAssetsData.RemoveAll(IsDeleted);
+
+		for(const TSharedPtr<FAssetData>& DeletedData:AssetsDataToDelete)
+		{
+			StoredAssetsDataByObjectPath.Remove(DeletedData->ObjectPath);
 		}
 
 		RefreshAssetListView();
@@ -433,15 +772,10 @@ TSharedRef<SButton> SAdvanceDeletionTab::ConstructSelectAllButton()
 
 FReply SAdvanceDeletionTab::OnSelectAllButtonClicked()
 {	
-	if(CheckBoxesArray.Num()==0) return FReply::Handled();
+	if(DisplayedAssetsData.Num()==0) return FReply::Handled();
 
-	for(const TSharedRef<SCheckBox>& CheckBox:CheckBoxesArray)
-	{	
-		if(!CheckBox->IsChecked())
-		{
-			CheckBox->ToggleCheckedState();
-		}		
-	}
+	//Every listed asset, including the rows that were never generated
+	AssetsDataToDelete.Append(DisplayedAssetsData);
 
 	return FReply::Handled();
 }
@@ -459,14 +793,11 @@ TSharedRef<SButton> SAdvanceDeletionTab::ConstructDeselectAllButton()
 
 FReply SAdvanceDeletionTab::OnDeselectAllButtonClicked()
 {	
-	if(CheckBoxesArray.Num()==0) return FReply::Handled();
+	if(DisplayedAssetsData.Num()==0) return FReply::Handled();
 
-	for(const TSharedRef<SCheckBox>& CheckBox:CheckBoxesArray)
+	for(const TSharedPtr<FAssetData>& DataSharedPtr:DisplayedAssetsData)
 	{
-		if(CheckBox->IsChecked())
-		{
-			CheckBox->ToggleCheckedState();
-		}
+		AssetsDataToDelete.Remove(DataSharedPtr);
 	}
 
 	return FReply::Handled();
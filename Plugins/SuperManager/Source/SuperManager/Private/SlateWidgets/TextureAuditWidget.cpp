@@ -0,0 +1,464 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SlateWidgets/TextureAuditWidget.h"
+#include "SlateBasics.h"
+#include "Widgets/Input/SSpinBox.h"
+#include "DebugHeader.h"
+#include "SuperManager.h"
+
+//Number of folders listed in the summary
+#define NumOfSummaryFolders 5
+
+void STextureAuditTab::Construct(const FArguments& InArgs)
+{
+	bCanSupportFocus = true;
+
+	AuditedFolders = InArgs._FoldersToAudit;
+
+	RunAudit();
+
+	FSlateFontInfo TitleTextFont = GetEmboseedTextFont();
+	TitleTextFont.Size = 30;
+
+	ChildSlot
+	[	//Main vertical box
+		SNew(SVerticalBox)
+
+		//First vertical slot for title text
+		+SVerticalBox::Slot()
+		.AutoHeight()
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(TEXT("Texture Memory Audit")))
+			.Font(TitleTextFont)
+			.Justification(ETextJustify::Center)
+			.ColorAndOpacity(FColor::White)
+		]
+
+		//Second slot for the totals and the biggest folders
+		+SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(5.f)
+		[
+			SNew(STextBlock)
+			.Text(this,&STextureAuditTab::GetSummaryText)
+			.ColorAndOpacity(FColor::White)
+		]
+
+		//Third slot for the audit options
+		+SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(5.f)
+		[
+			ConstructAuditOptions()
+		]
+
+		//Fourth slot for the texture list
+		+SVerticalBox::Slot()
+		.VAlign(VAlign_Fill)
+		[
+			ConstructEntryListView()
+		]
+
+		//Fifth slot for the buttons
+		+SVerticalBox::Slot()
+		.AutoHeight()
+		[
+			ConstructTabButtons()
+		]
+	];
+}
+
+void STextureAuditTab::RunAudit()
+{
+	TArray<FTextureAuditEntry> Entries;
+	FTextureMemoryAudit::AuditFolders(AuditedFolders,MaxAllowedSize,Entries);
+
+	const TMap<FName, int64> MemoryPerFolder = FTextureMemoryAudit::SumMemoryPerFolder(Entries);
+
+	AuditEntries.Empty(Entries.Num());
+	CheckedEntries.Empty();
+
+	int64 TotalMemory = 0;
+	int32 NumOfFlagged = 0;
+
+	for(FTextureAuditEntry& Entry:Entries)
+	{
+		TotalMemory += Entry.EstimatedMemoryInBytes;
+
+		if(Entry.IsFlagged()) ++NumOfFlagged;
+
+		AuditEntries.Add(MakeShared<FTextureAuditEntry>(MoveTemp(Entry)));
+	}
+
+	SummaryString = FString::Printf(TEXT("%d textures, estimated %s, %d flagged"),
+	AuditEntries.Num(),*FTextureMemoryAudit::FormatMemorySize(TotalMemory),NumOfFlagged);
+
+	int32 NumOfFoldersListed = 0;
+
+	for(const TPair<FName,int64>& FolderMemory:MemoryPerFolder)
+	{
+		if(NumOfFoldersListed++ >= NumOfSummaryFolders) break;
+
+		SummaryString.Append(TEXT("\n") + FolderMemory.Key.ToString() + TEXT("  ") + 
+		FTextureMemoryAudit::FormatMemorySize(FolderMemory.Value));
+	}
+
+	RefreshDisplayedEntries();
+}
+
+void STextureAuditTab::RefreshDisplayedEntries()
+{
+	DisplayedEntries.Empty();
+
+	for(const TSharedPtr<FTextureAuditEntry>& Entry:AuditEntries)
+	{
+		if(bShowFlaggedOnly && !Entry->IsFlagged()) continue;
+
+		DisplayedEntries.Add(Entry);
+	}
+
+	if(ConstructedEntryListView.IsValid())
+	{
+		ConstructedEntryListView->RequestListRefresh();
+	}
+}
+
+TSharedRef<SListView<TSharedPtr<FTextureAuditEntry>>> STextureAuditTab::ConstructEntryListView()
+{
+	ConstructedEntryListView = SNew(SListView< TSharedPtr <FTextureAuditEntry> >)
+	.ItemHeight(24.f)
+	.ListItemsSource(&DisplayedEntries)
+	.OnGenerateRow(this,&STextureAuditTab::OnGenerateRowForList)
+	.OnMouseButtonClick(this,&STextureAuditTab::OnRowWidgetMouseButtonClicked);
+
+	return ConstructedEntryListView.ToSharedRef();
+}
+
+#pragma region AuditSummary
+
+FText STextureAuditTab::GetSummaryText() const
+{
+	return FText::FromString(SummaryString);
+}
+
+#pragma endregion
+
+#pragma region AuditOptions
+
+TSharedRef<SWidget> STextureAuditTab::ConstructAuditOptions()
+{
+	return SNew(SHorizontalBox)
+
+	+SHorizontalBox::Slot()
+	.AutoWidth()
+	.VAlign(VAlign_Center)
+	[
+		ConstructTextForRowWidget(TEXT("Flag textures larger than "))
+	]
+
+	+SHorizontalBox::Slot()
+	.AutoWidth()
+	.Padding(5.f,0.f)
+	[
+		SNew(SSpinBox<int32>)
+		.MinValue(32)
+		.MaxValue(16384)
+		.Value(MaxAllowedSize)
+		.OnValueCommitted(this,&STextureAuditTab::OnMaxAllowedSizeCommitted)
+	]
+
+	+SHorizontalBox::Slot()
+	.AutoWidth()
+	.VAlign(VAlign_Center)
+	.Padding(20.f,0.f,5.f,0.f)
+	[
+		SNew(SCheckBox)
+		.IsChecked(bShowFlaggedOnly ? ECheckBoxState::Checked : ECheckBoxState::Unchecked)
+		.OnCheckStateChanged(this,&STextureAuditTab::OnShowFlaggedOnlyChanged)
+	]
+
+	+SHorizontalBox::Slot()
+	.AutoWidth()
+	.VAlign(VAlign_Center)
+	[
+		ConstructTextForRowWidget(TEXT("Show flagged only"))
+	];
+}
+
+void STextureAuditTab::OnMaxAllowedSizeCommitted(int32 NewValue, ETextCommit::Type CommitType)
+{
+	if(NewValue == MaxAllowedSize) return;
+
+	MaxAllowedSize = NewValue;
+
+	//Only the flags change, re-reading the tags is cheap enough to keep this simple
+	RunAudit();
+}
+
+void STextureAuditTab::OnShowFlaggedOnlyChanged(ECheckBoxState NewState)
+{
+	bShowFlaggedOnly = NewState == ECheckBoxState::Checked;
+
+	RefreshDisplayedEntries();
+}
+
+#pragma endregion
+
+#pragma region RowWidgetForEntryListView
+
+TSharedRef<ITableRow> STextureAuditTab::OnGenerateRowForList(TSharedPtr<FTextureAuditEntry> EntryToDisplay, 
+const TSharedRef<STableViewBase>& OwnerTable)
+{
+	if(!EntryToDisplay.IsValid()) return SNew(STableRow < TSharedPtr <FTextureAuditEntry> >,OwnerTable);
+
+	FString FlagsText;
+
+	if(EntryToDisplay->bOversized) FlagsText.Append(TEXT("Oversized "));
+	if(EntryToDisplay->bNonPowerOfTwo) FlagsText.Append(TEXT("NonPowerOfTwo"));
+
+	const FString DimensionsText = FString::Printf(TEXT("%dx%d"),EntryToDisplay->SizeX,EntryToDisplay->SizeY);
+
+	return SNew(STableRow < TSharedPtr <FTextureAuditEntry> >,OwnerTable).Padding(FMargin(2.f))
+	[
+		SNew(SHorizontalBox)
+
+		//First slot for check box
+		+SHorizontalBox::Slot()
+		.AutoWidth()
+		.VAlign(VAlign_Center)
+		[
+			SNew(SCheckBox)
+			.IsChecked_Lambda([this,EntryToDisplay]()
+			{
+				return CheckedEntries.Contains(EntryToDisplay) ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+			})
+			.OnCheckStateChanged_Lambda([this,EntryToDisplay](ECheckBoxState NewState)
+			{
+				NewState == ECheckBoxState::Checked ? 
+				(void)CheckedEntries.Add(EntryToDisplay) : (void)CheckedEntries.Remove(EntryToDisplay);
+			})
+		]
+
+		//Second slot for texture name
+		+SHorizontalBox::Slot()
+		.FillWidth(.4f)
+		.VAlign(VAlign_Center)
+		[
+			ConstructTextForRowWidget(EntryToDisplay->AssetData.AssetName.ToString())
+		]
+
+		//Third slot for dimensions
+		+SHorizontalBox::Slot()
+		.FillWidth(.15f)
+		.VAlign(VAlign_Center)
+		[
+			ConstructTextForRowWidget(DimensionsText)
+		]
+
+		//Fourth slot for pixel format
+		+SHorizontalBox::Slot()
+		.FillWidth(.15f)
+		.VAlign(VAlign_Center)
+		[
+			ConstructTextForRowWidget(EntryToDisplay->Format)
+		]
+
+		//Fifth slot for estimated memory
+		+SHorizontalBox::Slot()
+		.FillWidth(.15f)
+		.VAlign(VAlign_Center)
+		[
+			ConstructTextForRowWidget(FTextureMemoryAudit::FormatMemorySize(EntryToDisplay->EstimatedMemoryInBytes))
+		]
+
+		//Sixth slot for flags
+		+SHorizontalBox::Slot()
+		.FillWidth(.15f)
+		.VAlign(VAlign_Center)
+		[
+			ConstructTextForRowWidget(FlagsText,FSlateColor(FColor::Orange))
+		]
+	];
+}
+
+void STextureAuditTab::OnRowWidgetMouseButtonClicked(TSharedPtr<FTextureAuditEntry> ClickedEntry)
+{
+	FSuperManagerModule& SuperManagerModule = 
+	FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+
+	SuperManagerModule.SyncCBToClickedAssetForAssetList(ClickedEntry->AssetData.ObjectPath.ToString());
+}
+
+TSharedRef<STextBlock> STextureAuditTab::ConstructTextForRowWidget(const FString& TextContent, const FSlateColor& TextColor)
+{
+	return SNew(STextBlock)
+	.Text(FText::FromString(TextContent))
+	.ColorAndOpacity(TextColor);
+}
+
+#pragma endregion
+
+#pragma region TabButtons
+
+TSharedRef<SWidget> STextureAuditTab::ConstructTabButtons()
+{
+	return SNew(SHorizontalBox)
+
+	+SHorizontalBox::Slot()
+	.FillWidth(10.f)
+	.Padding(5.f)
+	[
+		SNew(SButton)
+		.ContentPadding(FMargin(5.f))
+		.OnClicked(this,&STextureAuditTab::OnSelectFlaggedButtonClicked)
+		[
+			ConstructTextForTabButtons(TEXT("Select Flagged"))
+		]
+	]
+
+	+SHorizontalBox::Slot()
+	.FillWidth(10.f)
+	.Padding(5.f)
+	[
+		SNew(SButton)
+		.ContentPadding(FMargin(5.f))
+		.OnClicked(this,&STextureAuditTab::OnDeselectAllButtonClicked)
+		[
+			ConstructTextForTabButtons(TEXT("Deselect All"))
+		]
+	]
+
+	+SHorizontalBox::Slot()
+	.AutoWidth()
+	.Padding(5.f)
+	.VAlign(VAlign_Center)
+	[
+		SNew(SSpinBox<int32>)
+		.MinValue(32)
+		.MaxValue(16384)
+		.Value_Lambda([this]() {return MaxTextureSizeToApply;})
+		.OnValueChanged_Lambda([this](int32 NewValue) {MaxTextureSizeToApply = NewValue;})
+	]
+
+	+SHorizontalBox::Slot()
+	.FillWidth(10.f)
+	.Padding(5.f)
+	[
+		SNew(SButton)
+		.ContentPadding(FMargin(5.f))
+		.OnClicked(this,&STextureAuditTab::OnApplyMaxTextureSizeButtonClicked)
+		[
+			ConstructTextForTabButtons(TEXT("Apply Max Size"))
+		]
+	]
+
+	+SHorizontalBox::Slot()
+	.AutoWidth()
+	.Padding(5.f)
+	.VAlign(VAlign_Center)
+	[
+		SNew(SSpinBox<int32>)
+		.MinValue(0)
+		.MaxValue(8)
+		.Value_Lambda([this]() {return LODBiasToApply;})
+		.OnValueChanged_Lambda([this](int32 NewValue) {LODBiasToApply = NewValue;})
+	]
+
+	+SHorizontalBox::Slot()
+	.FillWidth(10.f)
+	.Padding(5.f)
+	[
+		SNew(SButton)
+		.ContentPadding(FMargin(5.f))
+		.OnClicked(this,&STextureAuditTab::OnApplyLODBiasButtonClicked)
+		[
+			ConstructTextForTabButtons(TEXT("Apply LOD Bias"))
+		]
+	];
+}
+
+FReply STextureAuditTab::OnSelectFlaggedButtonClicked()
+{
+	for(const TSharedPtr<FTextureAuditEntry>& Entry:DisplayedEntries)
+	{
+		if(Entry->IsFlagged())
+		{
+			CheckedEntries.Add(Entry);
+		}
+	}
+
+	return FReply::Handled();
+}
+
+FReply STextureAuditTab::OnDeselectAllButtonClicked()
+{
+	CheckedEntries.Empty();
+
+	return FReply::Handled();
+}
+
+FReply STextureAuditTab::OnApplyMaxTextureSizeButtonClicked()
+{
+	const TArray<FAssetData> TexturesData = GetCheckedTexturesData();
+
+	if(TexturesData.Num()==0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok,TEXT("No texture currently selected"));
+		return FReply::Handled();
+	}
+
+	const int32 NumOfChanged = FTextureMemoryAudit::ApplyMaxTextureSize(TexturesData,MaxTextureSizeToApply);
+
+	DebugHeader::ShowNotifyInfo(TEXT("Set max texture size of ") + FString::FromInt(NumOfChanged) + TEXT(" textures"));
+
+	//Sizes, flags and totals changed with the rebuild
+	RunAudit();
+
+	return FReply::Handled();
+}
+
+FReply STextureAuditTab::OnApplyLODBiasButtonClicked()
+{
+	const TArray<FAssetData> TexturesData = GetCheckedTexturesData();
+
+	if(TexturesData.Num()==0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok,TEXT("No texture currently selected"));
+		return FReply::Handled();
+	}
+
+	const int32 NumOfChanged = FTextureMemoryAudit::ApplyLODBias(TexturesData,LODBiasToApply);
+
+	DebugHeader::ShowNotifyInfo(TEXT("Set LOD bias of ") + FString::FromInt(NumOfChanged) + TEXT(" textures"));
+
+	//Sizes, flags and totals changed with the rebuild
+	RunAudit();
+
+	return FReply::Handled();
+}
+
+TArray<FAssetData> STextureAuditTab::GetCheckedTexturesData() const
+{
+	TArray<FAssetData> TexturesData;
+
+	for(const TSharedPtr<FTextureAuditEntry>& CheckedEntry:CheckedEntries)
+	{
+		TexturesData.Add(CheckedEntry->AssetData);
+	}
+
+	return TexturesData;
+}
+
+TSharedRef<STextBlock> STextureAuditTab::ConstructTextForTabButtons(const FString& TextContent)
+{
+	FSlateFontInfo ButtonTextFont = GetEmboseedTextFont();
+	ButtonTextFont.Size = 15;
+
+	return SNew(STextBlock)
+	.Text(FText::FromString(TextContent))
+	.Font(ButtonTextFont)
+	.Justification(ETextJustify::Center);
+}
+
+#pragma endregion
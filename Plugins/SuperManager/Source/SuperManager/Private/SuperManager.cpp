@@ -8,6 +8,9 @@
 #include "AssetRegistryModule.h"
 #include "AssetToolsModule.h"
 #include "SlateWidgets/AdvanceDeletionWidget.h"
+#include "SlateWidgets/TextureAuditWidget.h"
+#include "AssetActions/NamingConventionAudit.h"
+#include "AssetActions/AssetPrefixResolver.h"
 #include "CustomStyle/SuperManagerStyle.h"
 #include "LevelEditor.h"
 #include "Engine/Selection.h"
@@ -26,6 +29,8 @@ void FSuperManagerModule::StartupModule()
 
 	RegisterAdvanceDeletionTab();
 
+	RegisterTextureAuditTab();
+
 	FSuperManagerUICommands::Register();
 	
 	InitCustomUICommands();
@@ -35,6 +40,10 @@ void FSuperManagerModule::StartupModule()
 	InitCustomSelectionEvent();
 
 	InitSceneOutlinerColumnExtension();
+
+	ActorLabelIndex.Initialize();
+
+	FAssetPrefixResolver::Get().Initialize();
 }
 
 #pragma region ContentBrowserMenuExtention
@@ -102,16 +111,26 @@ void FSuperManagerModule::AddCBMenuEntry(FMenuBuilder & MenuBuilder)
 		FSlateIcon(FSuperManagerStyle::GetStyleSetName(),"ContentBrowser.AdvanceDeletion"),	//Custom icon
 		FExecuteAction::CreateRaw(this,&FSuperManagerModule::OnAdvanceDeletionButtonClicked) //The actual function to excute
 	);
+
+	MenuBuilder.AddMenuEntry
+	(
+		FText::FromString(TEXT("Audit Naming Conventions")), //Title text for menu entry
+		FText::FromString(TEXT("List and fix assets whose names don't follow the prefix rules")), //Tooltip text
+		FSlateIcon(),
+		FExecuteAction::CreateRaw(this,&FSuperManagerModule::OnAuditNamingConventionsButtonClicked) //The actual function to excute
+	);
+
+	MenuBuilder.AddMenuEntry
+	(
+		FText::FromString(TEXT("Audit Texture Memory")), //Title text for menu entry
+		FText::FromString(TEXT("List textures under folder by estimated memory and fix oversized ones")), //Tooltip text
+		FSlateIcon(),
+		FExecuteAction::CreateRaw(this,&FSuperManagerModule::OnAuditTextureMemoryButtonClicked) //The actual function to excute
+	);
 }
 
 void FSuperManagerModule::OnDeleteUnsuedAssetButtonClicked()
 {	
-	if(ConstructedDockTab.IsValid())
-	{
-		DebugHeader::ShowMsgDialog(EAppMsgType::Ok,TEXT("Please close advance deletion tab before this operation"));
-		return;
-	}
-
 	if(FolderPathsSelected.Num()>1)
 	{
 		DebugHeader::ShowMsgDialog(EAppMsgType::Ok,TEXT("You can only do this to one folder"));
@@ -139,14 +158,7 @@ void FSuperManagerModule::OnDeleteUnsuedAssetButtonClicked()
 
 	for(const FString& AssetPathName:AssetsPathNames)
 	{
-		//Don't touch root folder
-		if(AssetPathName.Contains(TEXT("Developers"))||
-		AssetPathName.Contains(TEXT("Collections")) ||
-		AssetPathName.Contains(TEXT("__ExternalActors__")) ||
-		AssetPathName.Contains(TEXT("__ExternalObjects__")))
-		{
-			continue;
-		}
+		if(!ShouldListAssetPath(AssetPathName)) continue;
 
 		if(!UEditorAssetLibrary::DoesAssetExist(AssetPathName)) continue;
 
@@ -172,12 +184,6 @@ void FSuperManagerModule::OnDeleteUnsuedAssetButtonClicked()
 
 void FSuperManagerModule::OnDeleteEmptyFoldersButtonClicked()
 {	
-	if(ConstructedDockTab.IsValid())
-	{
-		DebugHeader::ShowMsgDialog(EAppMsgType::Ok,TEXT("Please close advance deletion tab before this operation"));
-		return;
-	}
-
 	FixUpRedirectors();
 
 	TArray<FString> FolderPathsArray = UEditorAssetLibrary::ListAssets(FolderPathsSelected[0],true,true);
@@ -188,13 +194,7 @@ void FSuperManagerModule::OnDeleteEmptyFoldersButtonClicked()
 
 	for(const FString& FolderPath:FolderPathsArray)
 	{
-		if(FolderPath.Contains(TEXT("Developers"))||
-		FolderPath.Contains(TEXT("Collections")) ||
-		FolderPath.Contains(TEXT("__ExternalActors__")) ||
-		FolderPath.Contains(TEXT("__ExternalObjects__")))
-		{
-			continue;
-		}
+		if(!ShouldListAssetPath(FolderPath)) continue;
 
 		if(!UEditorAssetLibrary::DoesDirectoryExist(FolderPath)) continue;
 
@@ -238,6 +238,67 @@ void FSuperManagerModule::OnAdvanceDeletionButtonClicked()
 	FGlobalTabmanager::Get()->TryInvokeTab(FName("AdvanceDeletion"));
 }
 
+void FSuperManagerModule::OnAuditNamingConventionsButtonClicked()
+{
+	//Registry metadata only, nothing gets loaded to find violations
+	TArray<FNamingViolation> Violations;
+	FNamingConventionAudit::FindViolations(FolderPathsSelected,Violations);
+
+	if(Violations.Num()==0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok,TEXT("No naming convention violation found under selected folder"),false);
+		return;
+	}
+
+	const FString ReportFilePath = FNamingConventionAudit::WriteReport(Violations);
+
+	//Only a preview in the dialog, the full list is in the report
+	FString ViolationsPreview;
+	const int32 NumOfPreviewLines = FMath::Min(Violations.Num(),20);
+
+	for(int32 ViolationIndex = 0; ViolationIndex<NumOfPreviewLines; ViolationIndex++)
+	{
+		ViolationsPreview.Append(Violations[ViolationIndex].AssetData.AssetName.ToString());
+		ViolationsPreview.Append(TEXT(" -> "));
+		ViolationsPreview.Append(Violations[ViolationIndex].SuggestedName);
+		ViolationsPreview.Append(TEXT("\n"));
+	}
+
+	if(Violations.Num()>NumOfPreviewLines)
+	{
+		ViolationsPreview.Append(TEXT("...\n"));
+	}
+
+	EAppReturnType::Type ConfirmResult =
+	DebugHeader::ShowMsgDialog(EAppMsgType::YesNo,TEXT("A total of ") + FString::FromInt(Violations.Num()) 
+	+ TEXT(" assets break the naming conventions.\nFull report written to ") + ReportFilePath 
+	+ TEXT("\n\n") + ViolationsPreview + TEXT("\nWould you like to rename all of them?"),false);
+
+	if(ConfirmResult == EAppReturnType::No) return;
+
+	const uint32 Counter = FNamingConventionAudit::FixViolations(Violations);
+
+	if(Counter>0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("Successfully renamed ") + FString::FromInt(Counter) + TEXT(" assets"));
+	}
+}
+
+void FSuperManagerModule::OnAuditTextureMemoryButtonClicked()
+{
+	//Invoking an open tab only brings it to front, give it an audit of the folders selected now
+	if(TSharedPtr<SDockTab> ExistingAuditTab = 
+	FGlobalTabmanager::Get()->FindExistingLiveTab(FTabId(FName("TextureMemoryAudit"))))
+	{
+		ExistingAuditTab->SetContent(
+			SNew(STextureAuditTab)
+			.FoldersToAudit(FolderPathsSelected)
+		);
+	}
+
+	FGlobalTabmanager::Get()->TryInvokeTab(FName("TextureMemoryAudit"));
+}
+
 void FSuperManagerModule::FixUpRedirectors()
 {
 	TArray<UObjectRedirector*> RedirectorsToFixArray;
@@ -305,14 +366,7 @@ TArray<TSharedPtr<FAssetData>> FSuperManagerModule::GetAllAssetDataUnderSelected
 
 	for(const FString& AssetPathName:AssetsPathNames)
 	{
-		//Don't touch root folder
-		if(AssetPathName.Contains(TEXT("Developers"))||
-		AssetPathName.Contains(TEXT("Collections")) ||
-		AssetPathName.Contains(TEXT("__ExternalActors__")) ||
-		AssetPathName.Contains(TEXT("__ExternalObjects__")))
-		{
-			continue;
-		}
+		if(!ShouldListAssetPath(AssetPathName)) continue;
 
 		if(!UEditorAssetLibrary::DoesAssetExist(AssetPathName)) continue;
 
@@ -324,6 +378,24 @@ TArray<TSharedPtr<FAssetData>> FSuperManagerModule::GetAllAssetDataUnderSelected
 	return AvaiableAssetsData;
 }
 
+void FSuperManagerModule::RegisterTextureAuditTab()
+{
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(FName("TextureMemoryAudit"),
+	FOnSpawnTab::CreateRaw(this,&FSuperManagerModule::OnSpawnTextureAuditTab))
+	.SetDisplayName(FText::FromString(TEXT("Texture Memory Audit")));
+}
+
+TSharedRef<SDockTab> FSuperManagerModule::OnSpawnTextureAuditTab(const FSpawnTabArgs& SpawnTabArgs)
+{
+	if(FolderPathsSelected.Num()==0) return SNew(SDockTab).TabRole(ETabRole::NomadTab);
+
+	return SNew(SDockTab).TabRole(ETabRole::NomadTab)
+	[
+		SNew(STextureAuditTab)
+		.FoldersToAudit(FolderPathsSelected)
+	];
+}
+
 void FSuperManagerModule::OnAdvanceDeletionTabClosed(TSharedRef<SDockTab> TabToClose)
 {
 	if(ConstructedDockTab.IsValid())
@@ -360,51 +432,13 @@ bool FSuperManagerModule::DeleteMultipleAssetsForAssetList(const TArray<FAssetDa
 	return false;
 }
 
-void FSuperManagerModule::ListUnusedAssetsForAssetList(const TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter, 
-TArray<TSharedPtr<FAssetData>>& OutUnusedAssetsData)
+//Don't touch root folders
+bool FSuperManagerModule::ShouldListAssetPath(const FString& AssetPathName) const
 {
-	OutUnusedAssetsData.Empty();
-
-	for(const TSharedPtr<FAssetData>& DataSharedPtr:AssetsDataToFilter)
-	{	
-		TArray<FString> AssetReferencers =
-		UEditorAssetLibrary::FindPackageReferencersForAsset(DataSharedPtr->ObjectPath.ToString());
-
-		if(AssetReferencers.Num()==0)
-		{
-			OutUnusedAssetsData.Add(DataSharedPtr);
-		}
-	}
-}
-
-void FSuperManagerModule::ListSameNameAssetsForAssetList(const TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter, 
-TArray<TSharedPtr<FAssetData>>& OutSameNameAssetsData)
-{
-	OutSameNameAssetsData.Empty();
-
-	//Multimap for supporting finding assets with same name
-	TMultiMap<FString, TSharedPtr<FAssetData> > AssetsInfoMultiMap;
-
-	for(const TSharedPtr<FAssetData>& DataSharedPtr:AssetsDataToFilter)
-	{
-		AssetsInfoMultiMap.Emplace(DataSharedPtr->AssetName.ToString(), DataSharedPtr);
-	}
-
-	for(const TSharedPtr<FAssetData>& DataSharedPtr:AssetsDataToFilter)
-	{	
-		TArray< TSharedPtr <FAssetData> > OutAssetsData;
-		AssetsInfoMultiMap.MultiFind(DataSharedPtr->AssetName.ToString(), OutAssetsData);
-
-		if(OutAssetsData.Num()<=1) continue;
-		
-		for(const TSharedPtr<FAssetData>& SameNameData:OutAssetsData)
-		{
-			if(SameNameData.IsValid())
-			{
-				OutSameNameAssetsData.AddUnique(SameNameData);
-			}
-		}
-	}
+	return !(AssetPathName.Contains(TEXT("Developers"))||
+	AssetPathName.Contains(TEXT("Collections")) ||
+	AssetPathName.Contains(TEXT("__ExternalActors__")) ||
+	AssetPathName.Contains(TEXT("__ExternalObjects__")));
 }
 
 void FSuperManagerModule::SyncCBToClickedAssetForAssetList(const FString & AssetPathToSync)
@@ -552,6 +586,9 @@ void FSuperManagerModule::InitCustomSelectionEvent()
 
 void FSuperManagerModule::OnActorSelected(UObject * SelectedObject)
 {	
+	//Fired for every actor of a batch selection, the batch has already left out locked actors
+	if(ActorSelectionBatchDepth>0) return;
+
 	if(!GetEditorActorSubsystem()) return;
 
 	if(AActor* SelectedActor = Cast<AActor>(SelectedObject))
@@ -701,12 +738,17 @@ void FSuperManagerModule::ShutdownModule()
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
 	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(FName("AdvanceDeletion"));
+	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(FName("TextureMemoryAudit"));
 
 	FSuperManagerStyle::ShutDown();
 
 	FSuperManagerUICommands::Unregister();
 
 	UnRegisterSceneOutlinerColumnExtension();
+
+	ActorLabelIndex.Shutdown();
+
+	FAssetPrefixResolver::Get().Shutdown();
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class UWorld;
+class ULevel;
+
+enum class EActorLabelMatchMode : uint8
+{
+	EALMM_Prefix,
+	EALMM_Token,
+	EALMM_Contains,
+	EALMM_Glob,
+	EALMM_Regex
+};
+
+/**
+ * Lookup of level actors by their label, one index per world.
+ * A world is indexed on its first query and then kept up to date from the actor
+ * added, deleted and label changed events and the loaded actor events of its levels,
+ * so queries don't scan every actor and copy every label. Labels are stored lowercase,
+ * sorted for prefix lookups and split into tokens (SM_Rock_01 -> sm, rock, 01) for token lookups.
+ * Undo and redo drop the indices, they can restore actors and labels without any of these events.
+ */
+class SUPERMANAGER_API FActorLabelIndex
+{
+public:
+	void Initialize();
+	void Shutdown();
+
+	void FindActors(UWorld* World, const FString& Pattern, EActorLabelMatchMode MatchMode, 
+	ESearchCase::Type SearchCase, TArray<AActor*>& OutActors);
+
+	//Label without its trailing number, StaticMeshActor_12 -> StaticMeshActor, SM_Rock2 -> SM_Rock
+	static FString StripNumericSuffix(const FString& ActorLabel);
+
+private:
+	struct FLabelEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FString Label;
+		FString LowerLabel;
+	};
+
+	struct FWorldLabelIndex
+	{
+		TArray<FLabelEntry> Entries;
+		TArray<int32> FreeEntryIndices;
+		TMap<TWeakObjectPtr<AActor>, int32> EntryIndexByActor;
+		TMap<FString, TArray<int32>> EntryIndicesByToken;
+
+		//Entry indices sorted by lowercase label, rebuilt on the first prefix query after a change
+		TArray<int32> SortedEntryIndices;
+		bool bSortedEntriesDirty = true;
+
+		//Loaded actor events of every indexed level, for actors World Partition loads and unloads
+		TArray< TPair <TWeakObjectPtr <ULevel>, FDelegateHandle> > LoadedActorAddedHandles;
+		TArray< TPair <TWeakObjectPtr <ULevel>, FDelegateHandle> > LoadedActorRemovedHandles;
+
+		~FWorldLabelIndex();
+
+		void AddActor(AActor* Actor);
+		void RemoveActor(AActor* Actor);
+		void SortEntries();
+	};
+
+	FWorldLabelIndex& GetIndexForWorld(UWorld* World);
+
+	void FindCandidates(FWorldLabelIndex& WorldIndex, const FString& LowerPattern, 
+	EActorLabelMatchMode MatchMode, TArray<int32>& OutEntryIndices) const;
+
+	void FindByPrefix(FWorldLabelIndex& WorldIndex, const FString& LowerPrefix, TArray<int32>& OutEntryIndices) const;
+
+	static void Tokenize(const FString& LowerLabel, TArray<FString>& OutTokens);
+
+	static bool ShouldIndexActor(const AActor* Actor);
+
+	void OnLevelActorAdded(AActor* AddedActor);
+	void OnLevelActorDeleted(AActor* DeletedActor);
+	void OnActorLabelChanged(AActor* RenamedActor);
+	void OnLoadedActorAdded(AActor& LoadedActor);
+	void OnLoadedActorRemoved(AActor& UnloadedActor);
+	void OnLevelChanged(ULevel* Level, UWorld* World);
+	void OnPostUndoRedo();
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+	TMap< TWeakObjectPtr <UWorld>, TUniquePtr <FWorldLabelIndex> > IndicesByWorld;
+
+	FDelegateHandle LevelActorAddedHandle;
+	FDelegateHandle LevelActorDeletedHandle;
+	FDelegateHandle ActorLabelChangedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+	FDelegateHandle WorldCleanupHandle;
+	FDelegateHandle PostUndoRedoHandle;
+};
@@ -0,0 +1,91 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+class AActor;
+class AStaticMeshActor;
+class UStaticMesh;
+class UMaterialInterface;
+class UInstancedStaticMeshComponent;
+class ULevel;
+
+//Static mesh actors with equal keys can be drawn as instances of one component
+//without losing their look, collision, mobility, tags or the level they belong to
+struct FInstancedMeshKey
+{
+	//Actors of different sublevels are never merged, the instanced actor is spawned into this level
+	ULevel* Level = nullptr;
+
+	UStaticMesh* StaticMesh = nullptr;
+	TArray<UMaterialInterface*> Materials;
+
+	FName CollisionProfileName;
+	ECollisionEnabled::Type CollisionEnabled = ECollisionEnabled::QueryAndPhysics;
+
+	//Movable copies stay movable, lighting and shadows match the source actors
+	EComponentMobility::Type Mobility = EComponentMobility::Static;
+	bool bCastShadow = true;
+
+	//Sorted, so actors with the same tags in another order end up in the same group
+	TArray<FName> Tags;
+
+	bool operator==(const FInstancedMeshKey& Other) const
+	{
+		return Level == Other.Level && StaticMesh == Other.StaticMesh && Materials == Other.Materials &&
+		CollisionProfileName == Other.CollisionProfileName && CollisionEnabled == Other.CollisionEnabled &&
+		Mobility == Other.Mobility && bCastShadow == Other.bCastShadow && Tags == Other.Tags;
+	}
+
+	friend uint32 GetTypeHash(const FInstancedMeshKey& Key)
+	{
+		uint32 Hash = HashCombine(GetTypeHash(Key.Level),GetTypeHash(Key.StaticMesh));
+
+		for(const UMaterialInterface* Material:Key.Materials)
+		{
+			Hash = HashCombine(Hash,GetTypeHash(Material));
+		}
+
+		Hash = HashCombine(Hash,GetTypeHash(Key.CollisionProfileName));
+		Hash = HashCombine(Hash,GetTypeHash(static_cast<uint8>(Key.CollisionEnabled)));
+		Hash = HashCombine(Hash,GetTypeHash(static_cast<uint8>(Key.Mobility)));
+		Hash = HashCombine(Hash,GetTypeHash(Key.bCastShadow));
+
+		for(const FName& Tag:Key.Tags)
+		{
+			Hash = HashCombine(Hash,GetTypeHash(Tag));
+		}
+
+		return Hash;
+	}
+};
+
+/**
+ * Builds actors holding one hierarchical instanced static mesh component,
+ * used to turn many copies of a static mesh into instances of a single component.
+ */
+class SUPERMANAGER_API FInstancedMeshBuilder
+{
+public:
+	//False when the actor has no static mesh to instance. Only reads the actor, safe to call in parallel
+	static bool MakeKey(const AStaticMeshActor* StaticMeshActor, FInstancedMeshKey& OutKey);
+
+	//Spawns an actor with a HISM component holding an instance at every world transform into the level of the key,
+	//has to be called inside a transaction to be undoable
+	static AActor* SpawnInstancedMeshActor(UWorld* World, const FInstancedMeshKey& Key, 
+	const TArray<FTransform>& InstanceWorldTransforms, const FString& ActorLabel);
+
+	//Instanced mesh components added to the actor in the editor. Foliage and components of the class
+	//or its construction script are left out, their instances can't be removed for good
+	static void GetExplodableComponents(AActor* Actor, TArray<UInstancedStaticMeshComponent*>& OutComponents);
+
+	//True for a plain actor holding only the HISM component SpawnInstancedMeshActor adds
+	static bool IsBuiltInstancedMeshActor(const AActor* Actor);
+
+	//Spawns a static mesh actor for every instance of the explodable components of the actor.
+	//Actors built by SpawnInstancedMeshActor are destroyed, otherwise the components are cleared.
+	//The spawned actors keep their default labels, the caller labels them
+	static void ExplodeInstancedMeshActor(AActor* InstancedMeshActor, TArray<AActor*>& OutSpawnedActors);
+};
@@ -4,8 +4,30 @@
 
 #include "CoreMinimal.h"
 #include "EditorUtilityWidget.h"
+#include "ActorEditorUtils.h"
 #include "QuickActorActionsWidget.generated.h"
 
+UENUM(BlueprintType)
+enum class E_LabelMatchMode : uint8
+{
+	ELMM_Prefix UMETA (DisplayName = "Prefix"),
+	ELMM_Token UMETA (DisplayName = "Whole Word"),
+	ELMM_Contains UMETA (DisplayName = "Contains"),
+	ELMM_Glob UMETA (DisplayName = "Wildcard"),
+	ELMM_Regex UMETA (DisplayName = "Regular Expression"),
+	ELMM_MAX UMETA (DisplayName = "Default Max")
+};
+
+UENUM(BlueprintType)
+enum class E_DuplicationPattern : uint8
+{
+	EDP_Linear UMETA (DisplayName = "Linear"),
+	EDP_Grid UMETA (DisplayName = "Grid"),
+	EDP_Radial UMETA (DisplayName = "Radial"),
+	EDP_Spline UMETA (DisplayName = "Along Spline"),
+	EDP_MAX UMETA (DisplayName = "Default Max")
+};
+
 UENUM(BlueprintType)
 enum class E_DuplicationAxis : uint8
 {
@@ -48,6 +70,16 @@ struct FRandomActorRotation
 	float RotRollMax = 45.f;
 
 };
+//Labels in use in the world and the next number per label, shared by all copies of one operation
+//so every copy gets a unique label without searching the world again
+struct FDuplicateLabelCache
+{
+	explicit FDuplicateLabelCache(UWorld* World) : ExistingActorLabels(World) {}
+
+	FCachedActorLabels ExistingActorLabels;
+	TMap<FString, int32> NextSuffixByBaseLabel;
+};
+
 /**
  * 
  */
@@ -66,6 +98,14 @@ public:
 	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorBatchSelection")
 	TEnumAsByte<ESearchCase::Type> SearchCase = ESearchCase::IgnoreCase;
 
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorBatchSelection")
+	E_LabelMatchMode LabelMatchMode = E_LabelMatchMode::ELMM_Prefix;
+
+	//Leave empty to search for the label of the selected actor without its trailing number,
+	//that label is searched as contained text in contains mode and as a prefix in every other mode
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorBatchSelection")
+	FString LabelSearchPattern;
+
 #pragma endregion
 
 #pragma region ActorBatchDuplication
@@ -74,14 +114,77 @@ public:
 	void DuplicateActors();
 
 	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorBatchDuplication")
+	E_DuplicationPattern DuplicationPattern = E_DuplicationPattern::EDP_Linear;
+
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorBatchDuplication",
+	meta = (EditCondition = "DuplicationPattern == E_DuplicationPattern::EDP_Linear",EditConditionHides))
 	E_DuplicationAxis AxisForDuplication = E_DuplicationAxis::EDA_XAxis;
 
-	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorBatchDuplication")
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorBatchDuplication",
+	meta = (EditCondition = "DuplicationPattern == E_DuplicationPattern::EDP_Linear",EditConditionHides))
 	int32 NumberOfDuplicates = 5;
 
-	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorBatchDuplication")
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorBatchDuplication",
+	meta = (EditCondition = "DuplicationPattern == E_DuplicationPattern::EDP_Linear",EditConditionHides))
 	float OffsetDist = 300.f;
 
+	//Number of cells along world X, Y and Z, the selected actor is the first cell
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorBatchDuplication",
+	meta = (EditCondition = "DuplicationPattern == E_DuplicationPattern::EDP_Grid",EditConditionHides))
+	FIntVector GridCount = FIntVector(5,5,1);
+
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorBatchDuplication",
+	meta = (EditCondition = "DuplicationPattern == E_DuplicationPattern::EDP_Grid",EditConditionHides))
+	FVector GridSpacing = FVector(300.f,300.f,300.f);
+
+	//Number of actors on the ring including the selected actor
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorBatchDuplication",
+	meta = (EditCondition = "DuplicationPattern == E_DuplicationPattern::EDP_Radial",EditConditionHides))
+	int32 RadialCount = 8;
+
+	//The ring is centered this far from the selected actor along world -X
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorBatchDuplication",
+	meta = (EditCondition = "DuplicationPattern == E_DuplicationPattern::EDP_Radial",EditConditionHides))
+	float RadialRadius = 500.f;
+
+	//A full ring spaces the actors evenly, a partial arc puts the last actor at its end
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorBatchDuplication",
+	meta = (EditCondition = "DuplicationPattern == E_DuplicationPattern::EDP_Radial",EditConditionHides,ClampMin = 0,ClampMax = 360))
+	float RadialArcAngle = 360.f;
+
+	//Number of copies spread evenly along the spline of the selected actor that has one,
+	//the spline actor itself is not duplicated
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorBatchDuplication",
+	meta = (EditCondition = "DuplicationPattern == E_DuplicationPattern::EDP_Spline",EditConditionHides))
+	int32 SplineCount = 10;
+
+	//Copies of radial and spline patterns follow the direction of the ring or the spline
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorBatchDuplication",
+	meta = (EditCondition = "DuplicationPattern == E_DuplicationPattern::EDP_Radial || DuplicationPattern == E_DuplicationPattern::EDP_Spline",EditConditionHides))
+	bool bAlignCopiesToPattern = true;
+
+	//Copies of static mesh actors become instances of one instanced mesh component per mesh and materials,
+	//other actors are still duplicated as actors
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorBatchDuplication")
+	bool bDuplicateAsInstances = false;
+
+#pragma endregion
+
+#pragma region ActorInstancing
+
+	//Replaces the selected static mesh actors with one instanced mesh actor per mesh, materials,
+	//collision and tags. Transforms are kept as instance transforms
+	UFUNCTION(BlueprintCallable)
+	void ConvertSelectedActorsToInstances();
+
+	//Turns every instance of the selected instanced mesh actors back into a static mesh actor
+	UFUNCTION(BlueprintCallable)
+	void ExplodeSelectedInstancesToActors();
+
+	//Groups with fewer actors are left as actors
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorInstancing",meta = (ClampMin = 1))
+	int32 MinActorsPerInstancedMesh = 2;
+
 #pragma endregion
 
 #pragma region RandomizeActorTransform
@@ -110,6 +213,57 @@ public:
 	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "RandomizeActorTransform",meta = (EditCondition = "bRandomizeOffset"))
 	float OffsetMax = 50.f;
 
+	//Uses RandomSeed instead of a new random seed every time. Same seed and same actors give the same result,
+	//every actor draws from its own stream so the result does not depend on the selection order
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "RandomizeActorTransform")
+	bool bUseFixedSeed = false;
+
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "RandomizeActorTransform",meta = (EditCondition = "bUseFixedSeed"))
+	int32 RandomSeed = 0;
+
+#pragma endregion
+
+#pragma region ActorScatter
+
+	//Places copies of the selected actors on the surfaces around them, spaced with Poisson-disk sampling
+	UFUNCTION(BlueprintCallable)
+	void ScatterSelectedActors();
+
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorScatter",meta = (ClampMin = 1))
+	int32 ScatterCount = 1000;
+
+	//Size of the area centered on the selected actors
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorScatter")
+	FVector2D ScatterAreaSize = FVector2D(5000.f,5000.f);
+
+	//No two copies are placed closer than this, fewer copies are placed when the area is full
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorScatter",meta = (ClampMin = 1))
+	float ScatterMinDistance = 100.f;
+
+	//Surfaces are searched this far above and below the selected actors
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorScatter")
+	float ScatterTraceHeight = 5000.f;
+
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorScatter")
+	TEnumAsByte<ECollisionChannel> ScatterTraceChannel = ECC_Visibility;
+
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorScatter")
+	bool bAlignToSurfaceNormal = true;
+
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorScatter",meta = (ClampMin = 0,ClampMax = 90))
+	float ScatterMaxSlopeAngle = 45.f;
+
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorScatter")
+	bool bRandomizeScatterYaw = true;
+
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorScatter")
+	int32 ScatterSeed = 0;
+
+	//Copies of static mesh actors become instances of one instanced mesh component per mesh,
+	//needed for large counts
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorScatter")
+	bool bScatterAsInstances = true;
+
 #pragma endregion
 
 private:
@@ -117,4 +271,17 @@ private:
 	class UEditorActorSubsystem* EditorActorSubsystem;
 
 	bool GetEditorActorSubsystem();
+
+	uint32 SelectActorsInBatch(const TArray<AActor*>& ActorsToSelect);
+
+	FVector GetDuplicationOffset(int32 DuplicateIndex) const;
+
+	void GetDuplicationTransforms(const AActor* SourceActor, const class USplineComponent* PathSpline,
+	TArray<FTransform>& OutTransforms) const;
+
+	AActor* SpawnDuplicateActor(AActor* SourceActor, const FTransform& DuplicateTransform, FDuplicateLabelCache& LabelCache);
+
+	FString GetUniqueLabel(const FString& Label, FDuplicateLabelCache& LabelCache) const;
+
+	FTransform GetRandomizedTransform(const FTransform& SourceTransform, FRandomStream& RandomStream) const;
 };
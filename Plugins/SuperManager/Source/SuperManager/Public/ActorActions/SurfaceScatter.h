@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+class AActor;
+
+struct FSurfaceScatterSettings
+{
+	//Area on the XY plane the points are spread over
+	FBox2D Region = FBox2D(ForceInit);
+
+	//Traces run from TraceTopZ down to TraceBottomZ at every point
+	float TraceTopZ = 0.f;
+	float TraceBottomZ = 0.f;
+
+	//No two points are closer than this
+	float MinDistance = 100.f;
+
+	int32 MaxPoints = 1000;
+
+	int32 Seed = 0;
+
+	ECollisionChannel TraceChannel = ECC_Visibility;
+
+	bool bAlignToSurfaceNormal = true;
+
+	//Hits on steeper surfaces are dropped
+	float MaxSlopeAngle = 45.f;
+
+	bool bRandomizeYaw = true;
+};
+
+//One surface hit, with the source it was assigned to
+struct FSurfaceScatterPoint
+{
+	FTransform Transform;
+	int32 SourceIndex = INDEX_NONE;
+};
+
+/**
+ * Spreads points over a region with Poisson-disk sampling and drops them onto the surfaces below.
+ */
+class SUPERMANAGER_API FSurfaceScatter
+{
+public:
+	//Bridson sampling backed by a uniform grid with one point per cell, neighbour checks only look at nearby cells.
+	//The region is filled completely, with the distance raised to fit about MaxPoints into it when the region
+	//holds far more, and a random subset of MaxPoints is kept. Runs as a cancellable slow task.
+	//False when the grid would be too large, or with an empty error message when cancelled
+	static bool GeneratePoissonPoints(const FBox2D& Region, float MinDistance, int32 MaxPoints,
+	FRandomStream& RandomStream, TArray<FVector2D>& OutPoints, FString& OutErrorMessage);
+
+	//Traces every point in parallel and keeps the hits within the slope limit. Source transforms
+	//give the rotation and scale of the copies, one source is picked per point from the seed
+	static void ProjectPointsToSurface(UWorld* World, const TArray<FVector2D>& Points,
+	const FSurfaceScatterSettings& Settings, const TArray<FTransform>& SourceTransforms,
+	const TArray<const AActor*>& IgnoredActors, TArray<FSurfaceScatterPoint>& OutScatterPoints);
+
+	static bool Scatter(UWorld* World, const FSurfaceScatterSettings& Settings, const TArray<FTransform>& SourceTransforms,
+	const TArray<const AActor*>& IgnoredActors, TArray<FSurfaceScatterPoint>& OutScatterPoints, FString& OutErrorMessage);
+};
@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Hands out asset names that are free in a folder.
+ * A name is checked with a direct asset registry lookup of its package, so the
+ * cost doesn't depend on the folder size. Names handed out are reserved, so a
+ * whole batch can be allocated up front before any asset is created.
+ */
+class FAssetNameAllocator
+{
+public:
+	//Allocates NumOfNames free names of the form BaseName_1, BaseName_2... in the folder
+	TArray<FString> AllocateSuffixedNames(const FName& PackagePath, const FString& BaseName, int32 NumOfNames);
+
+	bool IsNameUsed(const FName& PackagePath, const FString& AssetName) const;
+
+	void ReserveName(const FName& PackagePath, const FString& AssetName);
+
+private:
+	static FName MakePackageName(const FName& PackagePath, const FString& AssetName);
+
+	//Package names handed out in this batch, their assets may not exist yet
+	TSet<FName> ReservedPackageNames;
+
+	//Next suffix to try for a folder/base name, so repeated allocations don't restart from 1
+	TMap<FString, int32> NextSuffixByBaseName;
+};
@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+/**
+ * Resolves the naming prefix of an asset class from the prefix rules in USuperManagerSettings.
+ * A class without its own rule uses the rule of its closest parent class. The result of every
+ * class, including classes without any rule, is cached after the first lookup.
+ * Rules and results are keyed by class path, so rule classes are never loaded and a garbage
+ * collected class can't hand its prefix to another class. Reinstancing drops the results.
+ */
+class SUPERMANAGER_API FAssetPrefixResolver
+{
+public:
+	static FAssetPrefixResolver& Get();
+
+	void Initialize();
+	void Shutdown();
+
+	//Returns nullptr when neither the class nor any of its parents has a prefix rule
+	const FString* FindPrefix(const UClass* AssetClass);
+
+	//Class of the asset, or its closest native parent class when the asset's class is a Blueprint
+	//generated class that is not loaded. The parent is found through the registry's Blueprint
+	//inheritance, nothing is loaded. Returns nullptr when the class cannot be resolved
+	const UClass* ResolveAssetClass(const FAssetData& AssetData);
+
+private:
+	void RebuildRulesIfOutdated();
+
+	//Recompiled Blueprints can have another parent class under the same path
+	void OnObjectsReinstanced(const TMap<UObject*, UObject*>& OldToNewInstanceMap);
+
+	static FName GetClassPathName(const UClass* Class);
+
+	//Prefix rules as configured, keyed by the path of the exact class
+	TMap<FName, FString> PrefixRules;
+
+	//Memoized results of the hierarchy walk by class path, an empty string marks a class without any rule
+	TMap<FName, FString> ResolvedPrefixes;
+
+	//Native parents of unloaded Blueprint generated classes, nullptr marks a class that cannot be resolved
+	TMap<FName, const UClass*> NativeParentClassesByClassName;
+
+	uint32 CachedRulesRevision = MAX_uint32;
+
+	FDelegateHandle ObjectsReinstancedHandle;
+};
@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+struct FNamingViolation
+{
+	FAssetData AssetData;
+	FString ExpectedPrefix;
+	FString SuggestedName;
+};
+
+/**
+ * Checks asset names against the prefix rules in USuperManagerSettings.
+ * Works on asset registry metadata only, no package is loaded to find violations.
+ */
+class SUPERMANAGER_API FNamingConventionAudit
+{
+public:
+	//Finds every asset under the folders whose name doesn't start with the prefix of its class
+	static void FindViolations(const TArray<FString>& FolderPathsToAudit, TArray<FNamingViolation>& OutViolations);
+
+	static FString MakePrefixedName(FString AssetName, const FString& Prefix, const UClass* AssetClass);
+
+	//Renames the violating assets to their suggested names, returns the number renamed
+	static uint32 FixViolations(const TArray<FNamingViolation>& ViolationsToFix);
+
+	//Renames go out in chunks, each chunk loads and re-saves every referencing package only once
+	static uint32 RenameAssetsInBatches(const TArray<struct FAssetRenameData>& AssetsToRename);
+
+	//Writes the violations as csv to the project's Saved folder, returns the written file path
+	static FString WriteReport(const TArray<FNamingViolation>& Violations);
+
+private:
+	//Number of assets renamed in one transaction, loaded assets get garbage collected in between
+	static constexpr int32 RenameBatchSize = 512;
+
+	//Number of assets every parallel task checks
+	static constexpr int32 AuditChunkSize = 1024;
+};
@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "EditorUtilityWidget.h"
+#include "AssetActions/TextureRoleClassifier.h"
+#include "AssetActions/TextureSettingsBatch.h"
 #include "QuickMaterialCreationWidget.generated.h"
 
 UENUM(BlueprintType)
@@ -15,6 +17,19 @@ enum class E_ChannelPackingType : uint8
 
 	ECPT_MAX UMETA (DisplayName = "DefaultMAX")
 };
+//Everything the material creation needs once the textures are loaded, captured when the load is requested
+//so edits to the widget while loading don't change names that were already checked
+struct FMaterialCreationRequest
+{
+	//Checked and reserved before the load
+	FString MaterialName;
+	FString FolderPath;
+
+	E_ChannelPackingType ChannelPackingType = E_ChannelPackingType::ECPT_NoChannelPacking;
+	bool bUseMasterMaterial = false;
+	bool bCreateMaterialInstance = false;
+};
+
 /**
  * 
  */
@@ -44,8 +59,67 @@ public:
 
 #pragma endregion
 
+#pragma region MasterMaterial
+
+	//Create instances of one project master material instead of a unique material per texture set,
+	//the detected textures are assigned to the texture parameters below
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "MasterMaterial")
+	bool bUseMasterMaterial = false;
+
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "MasterMaterial",meta = (EditCondition = "bUseMasterMaterial"))
+	TSoftObjectPtr<UMaterialInterface> MasterMaterial;
+
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "MasterMaterial",meta = (EditCondition = "bUseMasterMaterial"))
+	FName BaseColorParameterName = TEXT("BaseColor");
+
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "MasterMaterial",meta = (EditCondition = "bUseMasterMaterial"))
+	FName MetallicParameterName = TEXT("Metallic");
+
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "MasterMaterial",meta = (EditCondition = "bUseMasterMaterial"))
+	FName RoughnessParameterName = TEXT("Roughness");
+
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "MasterMaterial",meta = (EditCondition = "bUseMasterMaterial"))
+	FName NormalParameterName = TEXT("Normal");
+
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "MasterMaterial",meta = (EditCondition = "bUseMasterMaterial"))
+	FName AmbientOcclusionParameterName = TEXT("AmbientOcclusion");
+
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "MasterMaterial",meta = (EditCondition = "bUseMasterMaterial"))
+	FName ORMParameterName = TEXT("ORM");
+
+#pragma endregion
+
+#pragma region BatchMaterialCreation
+
+	//Groups the textures into sets by their name without the role pattern, T_Rock01_BaseColor and
+	//T_Rock01_Normal become one set, and creates one material per set
+	UFUNCTION(BlueprintCallable)
+	void CreateMaterialsFromTextureSets();
+
+	//Use every texture in the folders of the selected assets instead of only the selected textures
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "CreateMaterialsFromTextureSets")
+	bool bIncludeWholeFolder = true;
+
+#pragma endregion
+
+#pragma region TextureSettingsFixUp
+
+	//Sets sRGB and compression of the mask and normal textures in the folders of the selected assets,
+	//roles are detected with the supported texture names below
+	UFUNCTION(BlueprintCallable)
+	void FixTextureSettingsInSelectedFolders();
+
+#pragma endregion
+
 #pragma region SupportedTextureNames
 
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "Supported Texture Names")
+	bool bIgnoreCaseInTextureNames = true;
+
+	//Name patterns only match between words, so _AO won't match inside _AOrta
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "Supported Texture Names")
+	bool bMatchWholeTokensOnly = true;
+
 	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "Supported Texture Names")
 	TArray<FString> BaseColorArray = {
 		TEXT("_BaseColor"),
@@ -94,11 +168,19 @@ private:
 
 #pragma region QuickMaterialCreationCore
 
-	bool ProcessSelectedData(const TArray<FAssetData>& SelectedDataToProccess, TArray<UTexture2D*>& OutSelectedTexturesArray,FString& OutSelectedTexturePackagePath);
-	bool CheckIsNameUsed(const FString& FolderPathToCheck, const FString& MaterialNameToCheck);
+	bool ProcessSelectedData(const TArray<FAssetData>& SelectedDataToProccess, TArray<FSoftObjectPath>& OutSelectedTexturePaths,FString& OutSelectedTexturePackagePath);
+	void OnSelectedTexturesLoaded(TArray<FSoftObjectPath> LoadedTexturePaths, FMaterialCreationRequest CreationRequest);
+	bool ReserveMaterialNames(class FAssetNameAllocator& NameAllocator,const FString& FolderPath,const FString& NameOfTheMaterial,FString& OutUsedName);
+	static FString MakeMaterialInstanceName(FString NameOfTheMaterial);
+	FTextureRoleClassifier CompileTextureRoleClassifier() const;
 	UMaterial* CreateMaterialAsset(const FString& NameOfTheMaterial, const FString& PathToPutMaterial);
-	void Default_CreateMaterialNodes(UMaterial* CreatedMaterial,UTexture2D* SelectedTexture,uint32& PinsConnectedCounter);
-	void ORM_CreateMaterialNodes(UMaterial* CreatedMaterial,UTexture2D* SelectedTexture,uint32& PinsConnectedCounter);
+	void Default_CreateMaterialNodes(UMaterial* CreatedMaterial,UTexture2D* SelectedTexture,ETextureRole TextureRole,uint32& PinsConnectedCounter);
+	void ORM_CreateMaterialNodes(UMaterial* CreatedMaterial,UTexture2D* SelectedTexture,ETextureRole TextureRole,uint32& PinsConnectedCounter);
+	void CreateMaterialNodesForTextures(UMaterial* CreatedMaterial,const TArray< TPair <UTexture2D*, ETextureRole> >& ClassifiedTextures,
+	E_ChannelPackingType PackingType,uint32& PinsConnectedCounter);
+	void RecompileMaterials(const TArray<UMaterial*>& MaterialsToRecompile);
+	UTexture2D* PackSeparateMasksIntoORM(TArray< TPair <UTexture2D*, ETextureRole> >& InOutClassifiedTextures,const FString& PackagePath,
+	const FString& PackedTextureName,class FAssetNameAllocator& NameAllocator);
 
 #pragma endregion
 
@@ -113,5 +195,16 @@ private:
 
 #pragma endregion
 
-	class UMaterialInstanceConstant* CreateMaterialInstanceAsset(UMaterial* CreatedMaterial,FString NameOfMaterialInstance,const FString& PathToPutMI);
+	class UMaterialInstanceConstant* CreateMaterialInstanceAsset(UMaterialInterface* ParentMaterial,FString NameOfMaterialInstance,const FString& PathToPutMI,
+	const TArray< TPair <UTexture2D*, ETextureRole> >& TextureParameters = TArray< TPair <UTexture2D*, ETextureRole> >());
+
+	FName GetTextureParameterNameForRole(ETextureRole TextureRole) const;
+
+	UMaterialInterface* LoadMasterMaterial();
+
+	//Keeps the selected textures loading until the material is created from them
+	TSharedPtr<struct FStreamableHandle> SelectedTexturesLoadHandle;
+
+	//Texture settings changes made while creating materials, applied once per operation
+	FTextureSettingsBatch TextureSettingsBatch;
 };
@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UTexture2D;
+
+/**
+ * Packs separate single channel mask textures into one RGB mask texture.
+ * Reads the top source mip of every input, so the result is packed from the
+ * uncompressed source art and not from the compressed platform data.
+ */
+class SUPERMANAGER_API FTextureChannelPacker
+{
+public:
+	//Packs AO, roughness and metallic into R, G and B of a new TC_Masks texture in the folder.
+	//Inputs can be null, missing channels get a neutral value. Inputs with other resolutions
+	//are resampled to the largest one
+	static UTexture2D* PackORM(UTexture2D* AOTexture, UTexture2D* RoughnessTexture, UTexture2D* MetallicTexture,
+	const FString& PackagePath, const FString& TextureName, FString& OutErrorMessage);
+
+private:
+	struct FChannelSource
+	{
+		//BGRA8 copy of the source mip, empty when the channel uses DefaultValue
+		TArray64<uint8> Pixels;
+		int32 SizeX = 0;
+		int32 SizeY = 0;
+		uint8 DefaultValue = 0;
+
+		uint8 Sample(int32 X, int32 Y, int32 DestSizeX, int32 DestSizeY) const;
+	};
+
+	static bool ReadChannelSource(UTexture2D* Texture, uint8 DefaultValue, FChannelSource& OutSource, FString& OutErrorMessage);
+
+	//Number of rows every parallel task packs
+	static constexpr int32 PackRowsPerTask = 16;
+};
@@ -0,0 +1,58 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+struct FTextureAuditEntry
+{
+	FAssetData AssetData;
+
+	int32 SizeX = 0;
+	int32 SizeY = 0;
+	int32 NumOfMips = 0;
+	int32 LODBias = 0;
+
+	//Pixel format of the platform data, DXT1, BC5, B8G8R8A8...
+	FString Format;
+
+	//Estimated memory of all mips with LOD bias applied
+	int64 EstimatedMemoryInBytes = 0;
+
+	bool bOversized = false;
+	bool bNonPowerOfTwo = false;
+
+	bool IsFlagged() const {return bOversized || bNonPowerOfTwo;}
+};
+
+/**
+ * Estimates texture memory from asset registry tags, so a whole project is
+ * audited without loading a single texture. Fixes go through FTextureSettingsBatch,
+ * only the textures being changed are loaded.
+ */
+class SUPERMANAGER_API FTextureMemoryAudit
+{
+public:
+	//Audits every texture 2D under the folders, textures larger than MaxAllowedSize on either side are flagged oversized
+	static void AuditFolders(const TArray<FString>& FolderPathsToAudit, int32 MaxAllowedSize, TArray<FTextureAuditEntry>& OutEntries);
+
+	//Estimated memory summed per folder
+	static TMap<FName, int64> SumMemoryPerFolder(const TArray<FTextureAuditEntry>& Entries);
+
+	//Returns the number of textures changed once they are rebuilt
+	static int32 ApplyMaxTextureSize(const TArray<FAssetData>& TexturesData, int32 MaxTextureSize);
+	static int32 ApplyLODBias(const TArray<FAssetData>& TexturesData, int32 LODBias);
+
+	static FString FormatMemorySize(int64 SizeInBytes);
+
+private:
+	static int32 ApplySettingsChange(const TArray<FAssetData>& TexturesData, const struct FTextureSettingsChange& Change);
+
+	static bool ReadEntryFromTags(const FAssetData& TextureData, FTextureAuditEntry& OutEntry);
+
+	static int64 EstimateMipChainMemory(int32 SizeX, int32 SizeY, int32 NumOfMips, const FString& Format);
+
+	//Number of textures every parallel task reads
+	static constexpr int32 AuditChunkSize = 1024;
+};
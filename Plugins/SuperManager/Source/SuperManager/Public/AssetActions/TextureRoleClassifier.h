@@ -0,0 +1,69 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class ETextureRole : uint8
+{
+	ETR_None,
+	ETR_BaseColor,
+	ETR_Metallic,
+	ETR_Roughness,
+	ETR_Normal,
+	ETR_AmbientOcclusion,
+	ETR_ORM
+};
+
+struct FTextureRoleMatch
+{
+	ETextureRole Role = ETextureRole::ETR_None;
+
+	//Position of the matched name pattern inside the texture name
+	int32 MatchStart = INDEX_NONE;
+	int32 MatchLength = 0;
+};
+
+/**
+ * Classifies texture names into material roles by their name patterns (_BaseColor, _Normal, _ORM...).
+ * All patterns are compiled into one Aho-Corasick automaton, so a name is classified in a single
+ * pass over its characters no matter how many patterns there are. When several patterns match,
+ * the longest one wins, e.g. _RoughnessMap over _Roughness.
+ */
+class SUPERMANAGER_API FTextureRoleClassifier
+{
+public:
+	void AddPatterns(ETextureRole Role, const TArray<FString>& Patterns);
+
+	//Builds the automaton, has to be called after adding patterns and before classifying
+	void Compile(bool bInIgnoreCase, bool bInMatchWholeTokens);
+
+	//Safe to call from multiple threads once compiled
+	bool Classify(const FString& TextureName, FTextureRoleMatch& OutMatch) const;
+
+private:
+	struct FPattern
+	{
+		FString Text;
+		ETextureRole Role = ETextureRole::ETR_None;
+	};
+
+	struct FTrieNode
+	{
+		TMap<TCHAR, int32> Children;
+		int32 FailLink = 0;
+
+		//Patterns ending at this node, including the ones reached through fail links
+		TArray<int32> PatternIndices;
+	};
+
+	TCHAR NormalizeChar(TCHAR Char) const {return bIgnoreCase ? FChar::ToLower(Char) : Char;}
+
+	bool IsOnTokenBoundary(const FString& TextureName, int32 MatchStart, int32 MatchLength) const;
+
+	TArray<FPattern> Patterns;
+	TArray<FTrieNode> Nodes;
+
+	bool bIgnoreCase = true;
+	bool bMatchWholeTokens = true;
+};
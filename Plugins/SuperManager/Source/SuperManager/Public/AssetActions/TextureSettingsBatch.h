@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "Engine/TextureDefines.h"
+#include "AssetActions/TextureRoleClassifier.h"
+
+class UTexture;
+
+//Settings a texture should end up with, unset values are left as they are
+struct SUPERMANAGER_API FTextureSettingsChange
+{
+	TOptional<TextureCompressionSettings> CompressionSettings;
+	TOptional<bool> bSRGB;
+	TOptional<int32> MaxTextureSize;
+	TOptional<int32> LODBias;
+
+	//Compression and sRGB a texture needs to be sampled in the given material role
+	static FTextureSettingsChange ForRole(ETextureRole TextureRole);
+
+	bool IsEmpty() const;
+
+	//Takes the values set in the other change over the ones set here
+	void Merge(const FTextureSettingsChange& OtherChange);
+
+	bool IsSatisfiedBy(const UTexture* Texture) const;
+
+	//Checks the registry tags without loading, false when a tag is missing so the texture gets loaded and checked
+	bool IsSatisfiedBy(const FAssetData& TextureData) const;
+};
+
+/**
+ * Collects texture settings changes and applies them in one pass.
+ * Textures already having the settings are skipped, the others get a single
+ * PostEditChange each and are rebuilt by the async texture compiler, so the
+ * recompression of the whole batch runs concurrently instead of one after another.
+ */
+class SUPERMANAGER_API FTextureSettingsBatch
+{
+public:
+	void QueueChange(UTexture* Texture, const FTextureSettingsChange& Change);
+
+	void QueueChangeForRole(UTexture* Texture, ETextureRole TextureRole);
+
+	int32 Num() const {return PendingChanges.Num();}
+
+	//Applies every queued change and empties the queue, returns the number of textures changed.
+	//bWaitForBuilds blocks until the rebuilt textures are compiled
+	int32 Apply(bool bWaitForBuilds = false);
+
+private:
+	TMap< TWeakObjectPtr <UTexture>, FTextureSettingsChange > PendingChanges;
+};
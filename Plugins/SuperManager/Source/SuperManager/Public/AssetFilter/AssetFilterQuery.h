@@ -0,0 +1,79 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+/**
+ * Compiled filter for the advance deletion tab.
+ *
+ * Query is a list of clauses joined by AND, every clause can be negated with NOT:
+ *   class=Texture2D AND unused AND size>4MB AND path under /Game/Old
+ *
+ * Supported clauses:
+ *   class=Name / class!=Name   asset class or any of its subclasses
+ *   name=Text / name~Text      exact asset name / asset name contains text
+ *   path under /Game/Folder    package path is the folder or inside it
+ *   size>4MB / size<100KB      package size on disk (B, KB, MB, GB)
+ *   unused                     no package references the asset
+ *   samename                   another asset in the list has the same name
+ *
+ * Values with spaces are quoted: name="My Asset", path under "/Game/My Folder".
+ *
+ * Predicates are sorted by cost so cheap metadata checks reject assets before
+ * package data or referencer lookups are done.
+ */
+class FAssetFilterQuery
+{
+public:
+	bool Compile(const FString& QueryString, FString& OutErrorMessage);
+
+	void Evaluate(const TArray< TSharedPtr <FAssetData> >& AssetsDataToFilter,
+	TArray< TSharedPtr <FAssetData> >& OutFilteredAssetsData) const;
+
+	bool IsEmpty() const {return Predicates.Num()==0;}
+
+	//True when the result for one asset depends on the other assets in the list
+	bool DependsOnWholeList() const {return bNeedsDuplicatedNames;}
+
+	//True when the result for one asset changes as other packages referencing it come and go
+	bool DependsOnReferencers() const {return bNeedsReferencers;}
+
+private:
+	enum class EPredicateCost : uint8
+	{
+		EPC_Metadata,
+		EPC_SetLookup,
+		EPC_PackageData,
+		EPC_References
+	};
+
+	struct FPredicateContext
+	{
+		//Names used by more than one asset in the list being filtered, only built when needed
+		TSet<FName> DuplicatedAssetNames;
+	};
+
+	struct FAssetPredicate
+	{
+		EPredicateCost Cost = EPredicateCost::EPC_Metadata;
+		bool bNegate = false;
+		TFunction<bool(const FAssetData&, const FPredicateContext&)> Test;
+	};
+
+	static bool Tokenize(const FString& QueryString, TArray<FString>& OutTokens, FString& OutErrorMessage);
+
+	//Value of a clause without its surrounding quotes, false when it is empty or has stray quotes
+	static bool ParseValue(FString ValueText, FString& OutValue);
+
+	bool CompileClause(FString Clause, FString& OutErrorMessage);
+
+	static bool ParseSizeInBytes(FString SizeText, int64& OutSizeInBytes);
+
+	TArray<FAssetPredicate> Predicates;
+
+	bool bNeedsDuplicatedNames = false;
+
+	bool bNeedsReferencers = false;
+};
@@ -0,0 +1,22 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "NamingConventionAuditCommandlet.generated.h"
+
+/**
+ * Headless naming convention audit, writes the violation report and optionally renames the assets.
+ * Usage: UnrealEditor-Cmd.exe Project.uproject -run=NamingConventionAudit [-Path=/Game/Folder] [-Fix]
+ */
+UCLASS()
+class SUPERMANAGER_API UNamingConventionAuditCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UNamingConventionAuditCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
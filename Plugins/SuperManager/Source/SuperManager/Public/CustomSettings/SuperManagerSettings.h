@@ -0,0 +1,35 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "SuperManagerSettings.generated.h"
+
+/**
+ * Project settings for SuperManager, found under Project Settings > Plugins > Super Manager
+ */
+UCLASS(config = Editor, defaultconfig, meta = (DisplayName = "Super Manager"))
+class SUPERMANAGER_API USuperManagerSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	USuperManagerSettings();
+
+	//Prefix added to assets of a class, subclasses without their own rule use the closest parent rule
+	UPROPERTY(config,EditAnywhere,Category = "Asset Naming",meta = (AllowAbstract = "true"))
+	TMap<TSoftClassPtr<UObject>,FString> AssetPrefixes;
+
+	//Bumped whenever the settings are edited, so cached lookups know to rebuild
+	uint32 GetPrefixRulesRevision() const {return PrefixRulesRevision;}
+
+	virtual FName GetCategoryName() const override {return FName("Plugins");}
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+	uint32 PrefixRulesRevision = 0;
+};
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Widgets/SCompoundWidget.h"
+#include "AssetFilter/AssetFilterQuery.h"
 
 class SAdvanceDeletionTab : public SCompoundWidget
 {
@@ -17,11 +18,14 @@ class SAdvanceDeletionTab : public SCompoundWidget
 public:
 	void Construct(const FArguments& InArgs);
 
+	virtual ~SAdvanceDeletionTab();
+
 private:
 	TArray< TSharedPtr <FAssetData> > StoredAssetsData;
 	TArray< TSharedPtr <FAssetData> > DisplayedAssetsData;
-	TArray< TSharedRef <SCheckBox> > CheckBoxesArray;
-	TArray< TSharedPtr < FAssetData> > AssetsDataToDeleteArray;
+
+	//Set, every visible checkbox looks itself up here on each paint
+	TSet< TSharedPtr <FAssetData> > AssetsDataToDelete;
 
 	TSharedRef< SListView< TSharedPtr <FAssetData> > > ConstructAssetListView();
 	TSharedPtr< SListView< TSharedPtr <FAssetData> > > ConstructedAssetListView;
@@ -43,6 +47,51 @@ private:
 
 #pragma endregion
 
+#pragma region FilterQueryForListingCondition
+
+	TSharedRef<SEditableTextBox> ConstructFilterQueryTextBox();
+
+	TSharedPtr<SEditableTextBox> FilterQueryTextBox;
+
+	void OnFilterQueryCommitted(const FText& CommittedText, ETextCommit::Type CommitType);
+
+	void ApplyFilterQuery(const FString& FilterQuery);
+
+	FAssetFilterQuery CurrentFilterQuery;
+
+#pragma endregion
+
+
+#pragma region LiveUpdateFromAssetRegistry
+
+	void SubscribeToAssetRegistry();
+	void UnsubscribeFromAssetRegistry();
+
+	void OnRegistryAssetAdded(const FAssetData& AddedAssetData);
+	void OnRegistryAssetRemoved(const FAssetData& RemovedAssetData);
+	void OnRegistryAssetRenamed(const FAssetData& RenamedAssetData, const FString& OldObjectPath);
+
+	bool IsAssetUnderSelectedFolder(const FAssetData& AssetData) const;
+
+	void ScheduleFlushPendingAssetChanges();
+	EActiveTimerReturnType FlushPendingAssetChanges(double InCurrentTime, float InDeltaTime);
+
+	//Filters the listed assets the given assets depend on again, for queries on referencers
+	void ReevaluateAssetsReferencedBy(const TArray< TSharedPtr <FAssetData> >& ReferencingAssetsData);
+
+	void RemoveHiddenAssetsFromDeletion();
+
+	FString SelectedFolder;
+
+	//Registry events are queued and applied to the list once per frame
+	TArray<FAssetData> PendingAddedAssetsData;
+	TSet<FName> PendingRemovedObjectPaths;
+	bool bFlushScheduled = false;
+
+	//Lookup from object path to the stored entry, so diffs don't scan the whole list
+	TMap< FName, TSharedPtr <FAssetData> > StoredAssetsDataByObjectPath;
+
+#pragma endregion
 
 #pragma region RowWidgetForAssetListView
 
@@ -53,8 +102,16 @@ private:
 	TSharedRef<SCheckBox> ConstructCheckBox(const TSharedPtr<FAssetData>& AssetDataToDisplay);
 	void OnCheckBoxStateChanged(ECheckBoxState NewState, TSharedPtr<FAssetData> AssetData);
 
+	//Rows are recycled while scrolling, so the check state is read from the assets to delete instead of kept in the widget
+	ECheckBoxState GetCheckBoxState(TSharedPtr<FAssetData> AssetData) const;
+
 	TSharedRef<STextBlock> ConstructTextForRowWidget(const FString& TextContent, const FSlateFontInfo& FontToUse);
 
+	TSharedRef<SWidget> ConstructThumbnailForRowWidget(const TSharedPtr<FAssetData>& AssetDataToDisplay);
+
+	//Shared by all rows, recycles thumbnail render targets of rows scrolled out of view
+	TSharedPtr<class FAssetThumbnailPool> AssetThumbnailPool;
+
 	TSharedRef<SButton> ConstructButtonForRowWidget(const TSharedPtr<FAssetData>& AssetDataToDisplay);
 	FReply OnDeleteButtonClicked(TSharedPtr<FAssetData> ClickedAssetData);
 
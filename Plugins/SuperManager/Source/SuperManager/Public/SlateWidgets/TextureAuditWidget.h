@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Widgets/SCompoundWidget.h"
+#include "AssetActions/TextureMemoryAudit.h"
+
+class STextureAuditTab : public SCompoundWidget
+{
+	SLATE_BEGIN_ARGS(STextureAuditTab) {}
+
+	SLATE_ARGUMENT(TArray<FString>,FoldersToAudit)
+
+	SLATE_END_ARGS()
+
+public:
+	void Construct(const FArguments& InArgs);
+
+private:
+	TArray<FString> AuditedFolders;
+
+	TArray< TSharedPtr <FTextureAuditEntry> > AuditEntries;
+	TArray< TSharedPtr <FTextureAuditEntry> > DisplayedEntries;
+	TSet< TSharedPtr <FTextureAuditEntry> > CheckedEntries;
+
+	void RunAudit();
+	void RefreshDisplayedEntries();
+
+	TSharedRef< SListView< TSharedPtr <FTextureAuditEntry> > > ConstructEntryListView();
+	TSharedPtr< SListView< TSharedPtr <FTextureAuditEntry> > > ConstructedEntryListView;
+
+#pragma region AuditSummary
+
+	FText GetSummaryText() const;
+
+	FString SummaryString;
+
+#pragma endregion
+
+#pragma region AuditOptions
+
+	TSharedRef<SWidget> ConstructAuditOptions();
+
+	int32 MaxAllowedSize = 2048;
+	bool bShowFlaggedOnly = true;
+
+	void OnMaxAllowedSizeCommitted(int32 NewValue, ETextCommit::Type CommitType);
+	void OnShowFlaggedOnlyChanged(ECheckBoxState NewState);
+
+#pragma endregion
+
+#pragma region RowWidgetForEntryListView
+
+	TSharedRef<ITableRow> OnGenerateRowForList(TSharedPtr<FTextureAuditEntry> EntryToDisplay,const TSharedRef<STableViewBase>& OwnerTable);
+
+	void OnRowWidgetMouseButtonClicked(TSharedPtr<FTextureAuditEntry> ClickedEntry);
+
+	TSharedRef<STextBlock> ConstructTextForRowWidget(const FString& TextContent, const FSlateColor& TextColor = FSlateColor(FColor::White));
+
+#pragma endregion
+
+#pragma region TabButtons
+
+	TSharedRef<SWidget> ConstructTabButtons();
+
+	int32 MaxTextureSizeToApply = 2048;
+	int32 LODBiasToApply = 1;
+
+	FReply OnSelectFlaggedButtonClicked();
+	FReply OnDeselectAllButtonClicked();
+	FReply OnApplyMaxTextureSizeButtonClicked();
+	FReply OnApplyLODBiasButtonClicked();
+
+	TArray<FAssetData> GetCheckedTexturesData() const;
+
+	TSharedRef<STextBlock> ConstructTextForTabButtons(const FString& TextContent);
+
+#pragma endregion
+
+	FSlateFontInfo GetEmboseedTextFont() const {return FCoreStyle::Get().GetFontStyle(FName("EmbossedText"));}
+};
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "ActorActions/ActorLabelIndex.h"
 
 class FSuperManagerModule : public IModuleInterface
 {
@@ -28,6 +29,8 @@ private:
 	void OnDeleteUnsuedAssetButtonClicked();
 	void OnDeleteEmptyFoldersButtonClicked();
 	void OnAdvanceDeletionButtonClicked();
+	void OnAuditNamingConventionsButtonClicked();
+	void OnAuditTextureMemoryButtonClicked();
 
 	void FixUpRedirectors();
 
@@ -44,6 +47,10 @@ private:
 
 	void OnAdvanceDeletionTabClosed(TSharedRef<SDockTab> TabToClose);
 
+	void RegisterTextureAuditTab();
+
+	TSharedRef<SDockTab> OnSpawnTextureAuditTab(const FSpawnTabArgs& SpawnTabArgs);
+
 #pragma endregion
 
 #pragma region LevelEditorMenuExtension
@@ -93,6 +100,9 @@ private:
 
 #pragma endregion
 
+	//Label lookup for selecting actors with similar names
+	FActorLabelIndex ActorLabelIndex;
+
 	TWeakObjectPtr<class UEditorActorSubsystem> WeakEditorActorSubsystem;
 
 	bool GetEditorActorSubsystem();
@@ -103,13 +113,22 @@ public:
 
 	bool DeleteSingleAssetForAssetList(const FAssetData& AssetDataToDelete);
 	bool DeleteMultipleAssetsForAssetList(const TArray<FAssetData>& AssetsToDelete);
-	void ListUnusedAssetsForAssetList(const TArray< TSharedPtr <FAssetData> >& AssetsDataToFilter,TArray< TSharedPtr <FAssetData> >& OutUnusedAssetsData);
-	void ListSameNameAssetsForAssetList(const TArray< TSharedPtr <FAssetData> >& AssetsDataToFilter, TArray< TSharedPtr <FAssetData> >& OutSameNameAssetsData);
+	bool ShouldListAssetPath(const FString& AssetPathName) const;
 	void SyncCBToClickedAssetForAssetList(const FString& AssetPathToSync);
 
 #pragma endregion
 
+	FActorLabelIndex& GetActorLabelIndex() {return ActorLabelIndex;}
+
 	bool CheckIsActorSelectionLocked(AActor* ActorToProcess);
 	void ProcessLockingForOutliner(AActor* ActorToProcess,bool bShouldLock);
 
+	//While a batch is open the per actor selection lock check is skipped,
+	//the caller filters locked actors itself before selecting them
+	void BeginActorSelectionBatch() {++ActorSelectionBatchDepth;}
+	void EndActorSelectionBatch() {ActorSelectionBatchDepth = FMath::Max(ActorSelectionBatchDepth-1,0);}
+
+private:
+	int32 ActorSelectionBatchDepth = 0;
+
 };